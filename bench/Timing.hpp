@@ -0,0 +1,60 @@
+#ifndef LIBCPPRIME_BENCH_TIMING
+#define LIBCPPRIME_BENCH_TIMING
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_RDTSC 1
+#endif
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+// The clock and thread pinning shared by the benchmarks that time single calls.
+// Now reads the time stamp counter between two fences on x86, where it ticks at a constant rate on recent CPUs, and steady_clock in nanoseconds elsewhere.
+#ifdef BENCH_HAS_RDTSC
+inline std::uint64_t Now() {
+    _mm_lfence();
+    const std::uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+// Ticks of the time stamp counter per nanosecond.
+inline double TicksPerNs() {
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t t0 = __rdtsc();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(50)) {}
+    const std::uint64_t t1 = __rdtsc();
+    return static_cast<double>(t1 - t0) / std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+#else
+inline std::uint64_t Now() { return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); }
+inline double TicksPerNs() { return 1; }
+#endif
+
+// The smallest number of ticks between two calls of Now, which is subtracted from every measured call.
+inline std::uint64_t TimerOverhead() {
+    std::uint64_t overhead = ~std::uint64_t(0);
+    for (int t = 0; t != 1000; ++t) {
+        const std::uint64_t t0 = Now();
+        const std::uint64_t t1 = Now();
+        overhead = t1 - t0 < overhead ? t1 - t0 : overhead;
+    }
+    return overhead;
+}
+
+// Pins the calling thread to cpu on Linux, so that the clock speed and the caches stay the same across the runs.
+inline void PinThread(const int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) std::fprintf(stderr, "failed to pin the thread\n");
+#else
+    static_cast<void>(cpu);
+#endif
+}
+
+#endif
@@ -0,0 +1,40 @@
+#include <libcpprime/IsPrime.hpp>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+template<class F> double Measure(F f) {
+    double best = 1e300;
+    for (int t = 0; t != 5; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = ns < best ? ns : best;
+    }
+    return best;
+}
+int main() {
+    constexpr std::size_t N = 1 << 18;
+    std::mt19937_64 rng(998244353);
+    const int widths[] = { 20, 24, 28, 32, 40, 49, 52, 56, 64 };
+    std::printf("bits,scalar_ns,batch_ns,speedup\n");
+    for (int bits : widths) {
+        std::vector<std::uint64_t> in(N);
+        for (auto& x : in) {
+            x = rng() >> (64 - bits) | 1 | (1ull << (bits - 1));
+            // Only numbers that reach the Miller-Rabin ladders are interesting here.
+            while (cppr::internal::HasSmallFactor(x)) x += 2;
+        }
+        std::unique_ptr<bool[]> out(new bool[N]);
+        std::size_t sum = 0;
+        double scalar = Measure([&] {
+            for (std::size_t i = 0; i != N; ++i) out[i] = cppr::IsPrime(in[i]);
+        });
+        for (std::size_t i = 0; i != N; ++i) sum += out[i];
+        double batch = Measure([&] { cppr::IsPrimeBatch(in.data(), N, out.get()); });
+        for (std::size_t i = 0; i != N; ++i) sum -= out[i];
+        if (sum != 0) return 1;
+        std::printf("%d,%.2f,%.2f,%.2f\n", bits, scalar / N, batch / N, scalar / batch);
+    }
+}
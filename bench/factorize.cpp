@@ -0,0 +1,39 @@
+#include <libcpprime/Factorize.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+template<class F> double Measure(F f) {
+    double best = 1e300;
+    for (int t = 0; t != 3; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = ns < best ? ns : best;
+    }
+    return best;
+}
+int main() {
+    constexpr std::size_t N = 256;
+    std::mt19937_64 rng(998244353);
+    const int widths[] = { 32, 40, 48, 56, 62, 64 };
+    std::printf("bits,random_us,semiprime_us\n");
+    for (int bits : widths) {
+        // Random numbers, and products of two primes of bits / 2 bits each.
+        std::vector<std::uint64_t> random(N), semiprimes;
+        for (auto& x : random) x = rng() >> (64 - bits) | (1ull << (bits - 1));
+        while (semiprimes.size() != N) {
+            const std::uint64_t p = rng() >> (64 - bits / 2) | (1ull << (bits / 2 - 1)), q = rng() >> (64 - bits / 2) | (1ull << (bits / 2 - 1));
+            if (cppr::IsPrime(p) && cppr::IsPrime(q)) semiprimes.push_back(p * q);
+        }
+        std::uint64_t sum = 0;
+        const double r = Measure([&] {
+            for (std::uint64_t x : random) sum += cppr::Factorize(x).size();
+        });
+        const double s = Measure([&] {
+            for (std::uint64_t x : semiprimes) sum += cppr::Factorize(x)[0].prime;
+        });
+        if (sum == 0) return 1;
+        std::printf("%d,%.2f,%.2f\n", bits, r / N / 1000, s / N / 1000);
+    }
+}
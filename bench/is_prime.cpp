@@ -0,0 +1,120 @@
+#include <libcpprime/IsPrime.hpp>
+#include <libcpprime/IsPrimeHashed.hpp>
+#include <libcpprime/IsPrimeNoTable.hpp>
+#include <libcpprime/Montgomery.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "./Timing.hpp"
+// usage: is_prime [csv|json] [cpu]
+// Every input set is generated from a fixed seed, so two builds see exactly the same inputs.
+// The cycle counts are read from the time stamp counter, which ticks at a constant rate on recent x86 CPUs.
+struct Bucket {
+    const char* name;
+    int low_bits, high_bits;  // inputs are in [2^low_bits, 2^high_bits)
+};
+constexpr Bucket Buckets[] = { { "<=16", 1, 16 }, { "<=32", 16, 32 }, { "<=49", 32, 49 }, { "<=62", 49, 62 }, { "<=64", 62, 64 } };
+constexpr const char* Distributions[] = { "uniform", "odd", "prime", "semiprime", "spsp2" };
+constexpr std::size_t N = 4096;
+std::uint64_t Uniform(std::mt19937_64& rng, int low_bits, int high_bits) {
+    const std::uint64_t lo = 1ull << low_bits, hi = high_bits == 64 ? 0 : 1ull << high_bits;
+    return lo + rng() % (hi - lo);
+}
+bool IsStrongProbablePrime2(std::uint64_t n) {
+    const cppr::Montgomery64<true> mint(n);
+    const std::int32_t s = cppr::internal::CountrZero(n - 1);
+    std::uint64_t x = mint.pow(mint.build(2), (n - 1) >> s);
+    if (mint.same(x, mint.one()) || mint.same(x, mint.neg(mint.one()))) return true;
+    for (std::int32_t i = 1; i != s; ++i) {
+        x = mint.mul(x, x);
+        if (mint.same(x, mint.neg(mint.one()))) return true;
+    }
+    return false;
+}
+std::uint64_t RandomPrime(std::mt19937_64& rng, int low_bits, int high_bits) {
+    while (true) {
+        const std::uint64_t x = Uniform(rng, low_bits, high_bits);
+        if (cppr::IsPrime(x)) return x;
+    }
+}
+std::vector<std::uint64_t> Generate(const Bucket& b, const std::string& dist, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::uint64_t> res;
+    if (dist == "spsp2" && b.high_bits <= 16) {
+        // There are only a few strong pseudoprimes to base 2 below 2^16, so they are repeated.
+        std::vector<std::uint64_t> all;
+        for (std::uint64_t x = 3; x < 65536; x += 2)
+            if (!cppr::IsPrime(x) && IsStrongProbablePrime2(x)) all.push_back(x);
+        while (res.size() != N) res.push_back(all[rng() % all.size()]);
+        return res;
+    }
+    while (res.size() != N) {
+        if (dist == "uniform") res.push_back(Uniform(rng, b.low_bits, b.high_bits));
+        else if (dist == "odd") res.push_back(Uniform(rng, b.low_bits, b.high_bits) | 1);
+        else if (dist == "prime") res.push_back(RandomPrime(rng, b.low_bits, b.high_bits));
+        else if (dist == "semiprime") {
+            const int half = (b.high_bits + 1) / 2;
+            const std::uint64_t p = RandomPrime(rng, half - 2, half), q = RandomPrime(rng, half - 2, half);
+            const std::uint64_t n = p * q;
+            if (cppr::internal::Mulu128High(p, q) == 0 && n >> b.low_bits != 0 && (b.high_bits == 64 || n >> b.high_bits == 0)) res.push_back(n);
+        } else {
+            // n = p(1 + m(p - 1)) is a strong pseudoprime to base 2 often enough for both factors being prime.
+            const int half = b.high_bits / 2;
+            const std::uint64_t p = Uniform(rng, half - 2, half - 1) | 1, m = 2 + rng() % 3, q = 1 + m * (p - 1);
+            const std::uint64_t n = p * q;
+            if (cppr::internal::Mulu128High(p, q) != 0 || n >> b.low_bits == 0 || (b.high_bits != 64 && n >> b.high_bits != 0)) continue;
+            if (cppr::IsPrime(p) && cppr::IsPrime(q) && IsStrongProbablePrime2(n)) res.push_back(n);
+        }
+    }
+    return res;
+}
+struct Result {
+    double ns, cycles;
+};
+template<class F> Result Measure(const std::vector<std::uint64_t>& in, F f) {
+    Result best = { 1e300, 1e300 };
+    std::uint64_t sink = 0;
+    for (int t = 0; t != 9; ++t) {
+#ifdef BENCH_HAS_RDTSC
+        const std::uint64_t c0 = Now();
+#endif
+        const auto start = std::chrono::steady_clock::now();
+        for (const std::uint64_t x : in) sink += f(x);
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+#ifdef BENCH_HAS_RDTSC
+        const double cycles = static_cast<double>(Now() - c0);
+#else
+        const double cycles = 0;
+#endif
+        if (ns < best.ns) best = { ns, cycles };
+    }
+    if (sink == 0xffffffffffffffff) std::printf(" ");
+    return { best.ns / in.size(), best.cycles / in.size() };
+}
+int main(int argc, char** argv) {
+    const bool json = argc > 1 && std::strcmp(argv[1], "json") == 0;
+    PinThread(argc > 2 ? std::atoi(argv[2]) : 0);
+    if (json) std::printf("[\n");
+    else std::printf("function,bucket,distribution,ns_per_call,calls_per_second,cycles_per_call\n");
+    bool first = true;
+    std::uint64_t seed = 998244353;
+    for (const Bucket& b : Buckets) {
+        for (const char* dist : Distributions) {
+            const std::vector<std::uint64_t> in = Generate(b, dist, seed++);
+            const Result results[5] = { Measure(in, [](std::uint64_t x) { return cppr::internal::IsPrimeBits<64, false>(x); }), Measure(in, [](std::uint64_t x) { return cppr::internal::IsPrimeBits<64, true>(x); }), Measure(in, [](std::uint64_t x) { return cppr::IsPrimeNoTable(x); }), Measure(in, [](std::uint64_t x) { return cppr::IsPrimeHashed<cppr::HashedBases32x256>(x); }), Measure(in, [](std::uint64_t x) { return cppr::IsPrimeHashed<cppr::HashedBases32x16>(x); }) };
+            const char* names[5] = { "IsPrime", "IsPrime+TrialDivision", "IsPrimeNoTable", "IsPrimeHashed32x256", "IsPrimeHashed32x16" };
+            for (int i = 0; i != 5; ++i) {
+                const Result& r = results[i];
+                if (json) {
+                    std::printf("%s  {\"function\": \"%s\", \"bucket\": \"%s\", \"distribution\": \"%s\", \"ns_per_call\": %.2f, \"calls_per_second\": %.0f, \"cycles_per_call\": %.1f}", first ? "" : ",\n", names[i], b.name, dist, r.ns, 1e9 / r.ns, r.cycles);
+                } else std::printf("%s,%s,%s,%.2f,%.0f,%.1f\n", names[i], b.name, dist, r.ns, 1e9 / r.ns, r.cycles);
+                first = false;
+            }
+        }
+    }
+    if (json) std::printf("\n]\n");
+}
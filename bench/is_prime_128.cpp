@@ -0,0 +1,42 @@
+#include <libcpprime/IsPrime128.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+template<class F> double Measure(F f) {
+    double best = 1e300;
+    for (int t = 0; t != 5; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = ns < best ? ns : best;
+    }
+    return best;
+}
+int main() {
+    constexpr std::size_t N = 1 << 12;
+    std::mt19937_64 rng(998244353);
+    const int widths[] = { 64, 65, 80, 96, 112, 127, 128 };
+    std::printf("bits,odd_ns,prime_ns\n");
+    for (int bits : widths) {
+        std::vector<unsigned __int128> odd(N), primes;
+        for (auto& x : odd) {
+            x = static_cast<unsigned __int128>(rng()) << 64 | rng();
+            x = x >> (128 - bits) | static_cast<unsigned __int128>(1) << (bits - 1) | 1;
+        }
+        for (std::size_t i = 0; primes.size() != N; ++i) {
+            if (cppr::IsPrime(odd[i % N] + 2 * (i / N))) primes.push_back(odd[i % N] + 2 * (i / N));
+        }
+        std::size_t odd_count = 0, prime_count = 0;
+        const double odd_ns = Measure([&] {
+            odd_count = 0;
+            for (const unsigned __int128 x : odd) odd_count += cppr::IsPrime(x);
+        });
+        const double prime_ns = Measure([&] {
+            prime_count = 0;
+            for (const unsigned __int128 x : primes) prime_count += cppr::IsPrime(x);
+        });
+        if (prime_count != N || odd_count == 0) return 1;
+        std::printf("%d,%.2f,%.2f\n", bits, odd_ns / N, prime_ns / N);
+    }
+}
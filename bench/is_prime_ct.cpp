@@ -0,0 +1,62 @@
+#include <libcpprime/IsPrime.hpp>
+#include <libcpprime/IsPrimeCT.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "./Timing.hpp"
+// usage: is_prime_ct [cpu]
+// Times single calls of cppr::IsPrime and cppr::IsPrimeCT on a mix of uniform numbers, odd numbers and primes of every width
+// from 1 to 64 bits, and prints the spread of the latency over the inputs.
+constexpr int Repeats = 15;
+volatile std::uint64_t input;
+volatile bool output;
+// The inputs are timed in Repeats rounds and the fastest call of each input is kept, so that interrupts and changes of the clock
+// speed, which last longer than a call, do not end up in the spread.
+template<class F> std::vector<double> Latencies(const std::vector<std::uint64_t>& in, F f, const std::uint64_t overhead, const double ticks_per_ns) {
+    std::vector<std::uint64_t> best(in.size(), ~std::uint64_t(0));
+    for (int t = 0; t != Repeats; ++t) {
+        for (std::size_t i = 0; i != in.size(); ++i) {
+            input = in[i];
+            const std::uint64_t t0 = Now();
+            output = f(input);
+            const std::uint64_t t1 = Now();
+            best[i] = std::min(best[i], t1 - t0);
+        }
+    }
+    std::vector<double> res;
+    for (const std::uint64_t t : best) res.push_back((t > overhead ? t - overhead : 0) / ticks_per_ns);
+    std::sort(res.begin(), res.end());
+    return res;
+}
+int main(int argc, char** argv) {
+    PinThread(argc > 1 ? std::atoi(argv[1]) : 0);
+    std::mt19937_64 rng(998244353);
+    std::vector<std::uint64_t> in;
+    for (int bits = 1; bits <= 64; ++bits) {
+        const std::uint64_t top = std::uint64_t(1) << (bits - 1);
+        for (int i = 0; i != 32; ++i) {
+            const std::uint64_t x = top | (rng() & (top - 1));
+            in.push_back(x), in.push_back(x | 1);
+            std::uint64_t p = x;
+            while (!cppr::IsPrime(p) && p >> (bits - 1) == 1) ++p;
+            if (cppr::IsPrime(p)) in.push_back(p);
+        }
+    }
+    for (const std::uint64_t x : in)
+        if (cppr::IsPrimeCT(x) != cppr::IsPrime(x)) return std::fprintf(stderr, "IsPrimeCT is wrong for %llu\n", static_cast<unsigned long long>(x)), 1;
+    const double ticks_per_ns = TicksPerNs();
+    const std::uint64_t overhead = TimerOverhead();
+    const std::vector<double> results[2] = { Latencies(in, [](std::uint64_t x) { return cppr::IsPrime(x); }, overhead, ticks_per_ns), Latencies(in, [](std::uint64_t x) { return cppr::IsPrimeCT(x); }, overhead, ticks_per_ns) };
+    const char* names[2] = { "IsPrime", "IsPrimeCT" };
+    std::printf("function,inputs,mean_ns,stddev_ns,min_ns,p50_ns,p99_ns,max_ns\n");
+    for (int i = 0; i != 2; ++i) {
+        const std::vector<double>& v = results[i];
+        double sum = 0, square = 0;
+        for (const double t : v) sum += t, square += t * t;
+        const double mean = sum / v.size();
+        std::printf("%s,%zu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n", names[i], v.size(), mean, std::sqrt(square / v.size() - mean * mean), v.front(), v[v.size() / 2], v[(v.size() * 99 - 1) / 100], v.back());
+    }
+}
@@ -0,0 +1,43 @@
+#include <libcpprime/NextPrime.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+template<class F> double Measure(F f) {
+    double best = 1e300;
+    for (int t = 0; t != 5; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = ns < best ? ns : best;
+    }
+    return best;
+}
+int main() {
+    constexpr std::size_t N = 1 << 16;
+    std::mt19937_64 rng(998244353);
+    const int widths[] = { 20, 32, 40, 49, 52, 62, 64 };
+    std::printf("bits,naive_ns,next_prime_ns,prev_prime_ns,speedup\n");
+    for (int bits : widths) {
+        std::vector<std::uint64_t> in(N);
+        for (auto& x : in) x = rng() >> (64 - bits) | (1ull << (bits - 1));
+        std::uint64_t naive_sum = 0, next_sum = 0, prev_sum = 0;
+        const double naive = Measure([&] {
+            naive_sum = 0;
+            for (std::uint64_t x : in) {
+                while (!cppr::IsPrime(x)) ++x;
+                naive_sum += x;
+            }
+        });
+        const double next = Measure([&] {
+            next_sum = 0;
+            for (std::uint64_t x : in) next_sum += cppr::NextPrime(x);
+        });
+        const double prev = Measure([&] {
+            prev_sum = 0;
+            for (std::uint64_t x : in) prev_sum += cppr::PrevPrime(x);
+        });
+        if (naive_sum != next_sum || prev_sum == 0) return 1;
+        std::printf("%d,%.2f,%.2f,%.2f,%.2f\n", bits, naive / N, next / N, prev / N, naive / next);
+    }
+}
@@ -0,0 +1,46 @@
+#include <libcpprime/ParallelSieve.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+template<class F> double Measure(F f) {
+    double best = 1e300;
+    for (int t = 0; t != 3; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = s < best ? s : best;
+    }
+    return best;
+}
+// usage: parallel [max_threads]
+int main(int argc, char** argv) {
+    const std::size_t hardware = std::thread::hardware_concurrency() != 0 ? std::thread::hardware_concurrency() : 1;
+    const std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : hardware;
+    const std::uint64_t ranges[][2] = {
+        { 0, 10000000000 },
+        { 1000000000000, 1010000000000 },
+        { 1000000000000000, 1000010000000000 },
+        { 1000000000000000000, 1000000001000000000 },
+    };
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+    std::printf("lo,hi,threads,count_s,for_each_s,count_speedup,for_each_speedup\n");
+    for (const auto& range : ranges) {
+        double count1 = 0, each1 = 0;
+        std::uint64_t expected = 0;
+        for (const std::size_t threads : thread_counts) {
+            std::uint64_t count = 0, sum = 0;
+            const double c = Measure([&] { count = cppr::CountPrimes(range[0], range[1], threads); });
+            const double e = Measure([&] {
+                sum = 0;
+                cppr::ForEachPrimeParallel(range[0], range[1], [&](std::uint64_t) { ++sum; }, threads);
+            });
+            if (threads == 1) count1 = c, each1 = e, expected = count;
+            if (count != expected || sum != expected) return 1;
+            std::printf("%llu,%llu,%zu,%.3f,%.3f,%.2f,%.2f\n", static_cast<unsigned long long>(range[0]), static_cast<unsigned long long>(range[1]), threads, c, e, count1 / c, each1 / e);
+        }
+    }
+}
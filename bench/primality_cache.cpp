@@ -0,0 +1,60 @@
+#include <libcpprime/PrimalityCache.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+// usage: primality_cache [threads] [zipf exponent]
+// The queries are drawn from 2^20 distinct 64-bit values that pass the check for small factors, half of them primes,
+// with the k-th most popular value drawn with probability proportional to k^-exponent.
+template<class F> double Measure(const std::vector<std::uint64_t>& in, std::size_t threads, F f) {
+    double best = 1e300;
+    for (int t = 0; t != 3; ++t) {
+        std::vector<std::thread> pool;
+        std::vector<std::uint64_t> sinks(threads);
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i != threads; ++i) {
+            pool.emplace_back([&, i] {
+                std::uint64_t sink = 0;
+                for (std::size_t j = i; j < in.size(); j += threads) sink += f(in[j]);
+                sinks[i] = sink;
+            });
+        }
+        for (std::thread& th : pool) th.join();
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = s < best ? s : best;
+        if (sinks[0] == 0xffffffffffffffff) std::printf(" ");
+    }
+    return best * 1e9 / in.size() * threads;
+}
+int main(int argc, char** argv) {
+    const std::size_t threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1;
+    const double exponent = argc > 2 ? std::atof(argv[2]) : 1.0;
+    std::mt19937_64 rng(998244353);
+    std::vector<std::uint64_t> values;
+    std::size_t primes = 0;
+    while (values.size() != (1 << 20)) {
+        const std::uint64_t x = rng() | (1ull << 63) | 1;
+        if (cppr::internal::HasSmallFactor(x)) continue;
+        const bool p = cppr::IsPrime(x);
+        if (p ? primes * 2 < (1 << 20) : values.size() - primes < (1 << 19)) values.push_back(x), primes += p;
+    }
+    std::shuffle(values.begin(), values.end(), rng);
+    std::vector<double> cdf(values.size());
+    double total = 0;
+    for (std::size_t k = 0; k != values.size(); ++k) cdf[k] = total += std::pow(static_cast<double>(k + 1), -exponent);
+    std::vector<std::uint64_t> in(1 << 22);
+    std::uniform_real_distribution<double> dist(0, total);
+    for (std::uint64_t& x : in) x = values[std::min<std::size_t>(std::lower_bound(cdf.begin(), cdf.end(), dist(rng)) - cdf.begin(), values.size() - 1)];
+    std::printf("function,capacity,threads,ns_per_call,hit_rate\n");
+    std::printf("IsPrime,0,%zu,%.2f,0\n", threads, Measure(in, threads, [](std::uint64_t x) { return cppr::IsPrime(x); }));
+    for (const std::size_t capacity : { 1 << 12, 1 << 16, 1 << 20 }) {
+        cppr::PrimalityCache cache(capacity);
+        const double ns = Measure(in, threads, [&](std::uint64_t x) { return cache.is_prime(x); });
+        const cppr::PrimalityCache::Stats stats = cache.stats();
+        std::printf("PrimalityCache,%zu,%zu,%.2f,%.3f\n", cache.capacity(), threads, ns, static_cast<double>(stats.hits) / (stats.hits + stats.misses));
+    }
+}
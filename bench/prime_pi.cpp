@@ -0,0 +1,27 @@
+#include <libcpprime/PrimePi.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+// usage: prime_pi [max_exponent] [threads]
+// Times cppr::PrimePi and cppr::PrimeSum at the powers of ten from 10^9 and checks pi against the known values.
+int main(int argc, char** argv) {
+    const int max_exponent = argc > 1 ? std::atoi(argv[1]) : 15;
+    const std::size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+    const std::uint64_t expected[] = { 50847534, 455052511, 4118054813, 37607912018, 346065536839, 3204941750802, 29844570422669, 279238341033925, 2623557157654233, 24739954287740860 };
+    std::printf("x,threads,pi,pi_s,sum_s\n");
+    std::uint64_t x = 1000000000;
+    for (int e = 9; e <= max_exponent && e <= 18; ++e, x *= 10) {
+        auto start = std::chrono::steady_clock::now();
+        const std::uint64_t pi = cppr::PrimePi(x, threads);
+        const double pi_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (pi != expected[e - 9]) return std::fprintf(stderr, "wrong result at 10^%d\n", e), 1;
+        double sum_s = 0;
+#if defined(__SIZEOF_INT128__)
+        start = std::chrono::steady_clock::now();
+        const unsigned __int128 sum = cppr::PrimeSum(x, threads);
+        sum_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (sum == 0) return 1;
+#endif
+        std::printf("1e%d,%zu,%llu,%.3f,%.3f\n", e, threads, static_cast<unsigned long long>(pi), pi_s, sum_s);
+    }
+}
@@ -0,0 +1,50 @@
+#include <libcpprime/PrimeView.hpp>
+#include <chrono>
+#include <cstdio>
+#include <initializer_list>
+template<class F> double Measure(F f) {
+    double best = 1e300;
+    for (int t = 0; t != 5; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = ns < best ? ns : best;
+    }
+    return best;
+}
+// Compares iterating cppr::primes with the callback of cppr::ForEachPrime over whole ranges,
+// and the cost of the first few primes after a large starting point.
+int main() {
+    const std::uint64_t starts[] = { 0, 1000000000000, 1000000000000000000 };
+    std::printf("lo,width,for_each_ns_per_prime,view_ns_per_prime\n");
+    for (const std::uint64_t lo : starts) {
+        const std::uint64_t width = 300000000;
+        std::uint64_t sink = 0, count = 0;
+        const double for_each = Measure([&] {
+            count = 0;
+            cppr::ForEachPrime(lo, lo + width, [&](std::uint64_t p) { sink += p, ++count; });
+        });
+        const double view = Measure([&] {
+            for (const std::uint64_t p : cppr::primes(lo, lo + width)) sink += p;
+        });
+        if (sink == 0) return 1;
+        std::printf("%llu,%llu,%.2f,%.2f\n", static_cast<unsigned long long>(lo), static_cast<unsigned long long>(width), for_each / count, view / count);
+    }
+    std::printf("lo,taken,view_ns,for_each_window_ns\n");
+    for (const std::uint64_t lo : starts) {
+        for (const std::uint32_t taken : { 10u, 1000u, 100000u }) {
+            std::uint64_t sink = 0, last = 0;
+            const double view = Measure([&] {
+                std::uint32_t i = 0;
+                for (const std::uint64_t p : cppr::primes(lo, 18446744073709551615u)) {
+                    sink += p, last = p;
+                    if (++i == taken) break;
+                }
+            });
+            // ForEachPrime over a window that is known in advance to hold exactly the primes the view produced.
+            const double for_each = Measure([&] { cppr::ForEachPrime(lo, last + 1, [&](std::uint64_t p) { sink += p; }); });
+            if (sink == 0) return 1;
+            std::printf("%llu,%u,%.0f,%.0f\n", static_cast<unsigned long long>(lo), taken, view, for_each);
+        }
+    }
+}
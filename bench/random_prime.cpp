@@ -0,0 +1,46 @@
+#include <libcpprime/RandomPrime.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+template<class F> double Measure(F f) {
+    double best = 1e300;
+    for (int t = 0; t != 5; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = ns < best ? ns : best;
+    }
+    return best;
+}
+int main() {
+    constexpr int N = 1 << 14, M = 1 << 8;
+    const int widths[] = { 24, 32, 40, 49, 56, 62, 64 };
+    std::printf("bits,rejection_ns,random_prime_ns,speedup,safe_rejection_ns,random_safe_prime_ns,speedup\n");
+    for (int bits : widths) {
+        std::mt19937_64 rng(998244353);
+        std::uniform_int_distribution<std::uint64_t> dist(1ull << (bits - 1), (1ull << (bits - 1)) + ((1ull << (bits - 1)) - 1));
+        std::uint64_t sink = 0;
+        const double rejection = Measure([&] {
+            for (int i = 0; i != N; ++i) {
+                std::uint64_t x = 0;
+                while (!cppr::IsPrime(x = dist(rng) | 1)) {}
+                sink += x;
+            }
+        });
+        const double random = Measure([&] {
+            for (int i = 0; i != N; ++i) sink += cppr::RandomPrime(bits, rng);
+        });
+        const double safe_rejection = Measure([&] {
+            for (int i = 0; i != M; ++i) {
+                std::uint64_t x = 0;
+                while (!(cppr::IsPrime(x = dist(rng) | 1) && cppr::IsPrime(x >> 1))) {}
+                sink += x;
+            }
+        });
+        const double safe = Measure([&] {
+            for (int i = 0; i != M; ++i) sink += cppr::RandomSafePrime(bits, rng);
+        });
+        if (sink == 0) return 1;
+        std::printf("%d,%.1f,%.1f,%.2f,%.1f,%.1f,%.2f\n", bits, rejection / N, random / N, rejection / random, safe_rejection / M, safe / M, safe_rejection / safe);
+    }
+}
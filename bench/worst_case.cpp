@@ -0,0 +1,82 @@
+#include <libcpprime/IsPrime.hpp>
+#include <libcpprime/IsPrimeCT.hpp>
+#include <libcpprime/IsPrimeHashed.hpp>
+#include <libcpprime/IsPrimeNoTable.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "./Timing.hpp"
+// usage: worst_case [corpus] [csv|json] [cpu]
+// Reads the corpus written by tools/gen_corpus.cpp (default ./bench/Adversarial.txt) and reports the latency of single calls
+// for each kind and bit range of input: the mean, the median, the 99th percentile and the maximum over the inputs.
+// Each input is timed Repeats times on its own and its fastest call is kept, which removes interrupts and cache misses
+// but keeps the cost that depends on the input, so the maximum is the worst case over the corpus.
+struct Entry {
+    std::string kind, bucket;
+    bool expected;
+    std::uint64_t n;
+};
+constexpr int Repeats = 15;
+volatile std::uint64_t input;
+volatile bool output;
+template<class F> std::uint64_t Latency(const std::uint64_t n, F f, const std::uint64_t overhead) {
+    std::uint64_t best = ~std::uint64_t(0);
+    for (int t = 0; t != Repeats; ++t) {
+        input = n;
+        const std::uint64_t t0 = Now();
+        output = f(input);
+        const std::uint64_t t1 = Now();
+        best = std::min(best, t1 - t0);
+    }
+    return best > overhead ? best - overhead : 0;
+}
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "./bench/Adversarial.txt";
+    const bool json = argc > 2 && std::strcmp(argv[2], "json") == 0;
+    PinThread(argc > 3 ? std::atoi(argv[3]) : 0);
+    std::vector<Entry> corpus;
+    {
+        std::ifstream ifs(path);
+        if (!ifs) return std::fprintf(stderr, "failed to open %s\n", path), 1;
+        std::string line;
+        while (std::getline(ifs, line)) {
+            std::istringstream ss(line);
+            Entry e;
+            unsigned long long n = 0;
+            if (ss >> e.kind >> e.bucket >> e.expected >> n) e.n = n, corpus.push_back(e);
+        }
+    }
+    const double ticks_per_ns = TicksPerNs();
+    const std::uint64_t overhead = TimerOverhead();
+    typedef bool (*Function)(std::uint64_t);
+    const Function functions[6] = { [](std::uint64_t x) { return cppr::internal::IsPrimeBits<64, false>(x); }, [](std::uint64_t x) { return cppr::internal::IsPrimeBits<64, true>(x); }, [](std::uint64_t x) { return cppr::IsPrimeNoTable(x); }, [](std::uint64_t x) { return cppr::IsPrimeHashed<cppr::HashedBases32x256>(x); }, [](std::uint64_t x) { return cppr::IsPrimeHashed<cppr::HashedBases32x16>(x); }, [](std::uint64_t x) { return cppr::IsPrimeCT(x); } };
+    const char* names[6] = { "IsPrime", "IsPrime+TrialDivision", "IsPrimeNoTable", "IsPrimeHashed32x256", "IsPrimeHashed32x16", "IsPrimeCT" };
+    if (json) std::printf("[\n");
+    else std::printf("function,kind,bucket,inputs,mean_ns,p50_ns,p99_ns,max_ns,max_input\n");
+    bool first = true;
+    for (int i = 0; i != 6; ++i) {
+        for (std::size_t begin = 0, end = 0; begin != corpus.size(); begin = end) {
+            while (end != corpus.size() && corpus[end].kind == corpus[begin].kind && corpus[end].bucket == corpus[begin].bucket) ++end;
+            std::vector<std::pair<std::uint64_t, std::uint64_t>> latency;
+            double sum = 0;
+            for (std::size_t j = begin; j != end; ++j) {
+                if (functions[i](corpus[j].n) != corpus[j].expected) return std::fprintf(stderr, "%s is wrong for %llu\n", names[i], static_cast<unsigned long long>(corpus[j].n)), 1;
+                latency.emplace_back(Latency(corpus[j].n, functions[i], overhead), corpus[j].n);
+                sum += static_cast<double>(latency.back().first);
+            }
+            std::sort(latency.begin(), latency.end());
+            const std::size_t n = latency.size();
+            const double mean = sum / n / ticks_per_ns, p50 = latency[n / 2].first / ticks_per_ns, p99 = latency[(n * 99 - 1) / 100].first / ticks_per_ns, max = latency.back().first / ticks_per_ns;
+            const Entry& e = corpus[begin];
+            if (json) std::printf("%s  {\"function\": \"%s\", \"kind\": \"%s\", \"bucket\": \"%s\", \"inputs\": %zu, \"mean_ns\": %.1f, \"p50_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f, \"max_input\": %llu}", first ? "" : ",\n", names[i], e.kind.c_str(), e.bucket.c_str(), n, mean, p50, p99, max, static_cast<unsigned long long>(latency.back().second));
+            else std::printf("%s,%s,%s,%zu,%.1f,%.1f,%.1f,%.1f,%llu\n", names[i], e.kind.c_str(), e.bucket.c_str(), n, mean, p50, p99, max, static_cast<unsigned long long>(latency.back().second));
+            first = false;
+        }
+    }
+    if (json) std::printf("\n]\n");
+}
@@ -0,0 +1,192 @@
+/**
+ * libcpprime Factorize.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#include "./IsPrime.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_FACTORIZE
+#define LIBCPPRIME_INCLUDED_FACTORIZE
+
+namespace cppr {
+
+struct PrimePower {
+    std::uint64_t prime;
+    std::int32_t exponent;
+};
+
+namespace internal {
+    class Factorizer;
+}  // namespace internal
+
+// The prime factorization of a 64-bit integer, in increasing order of the primes.
+// No 64-bit integer has more than 15 distinct prime factors, so they are stored inline.
+class FactorizeResult {
+public:
+    static constexpr std::size_t Capacity = 15;
+
+private:
+    PrimePower factors_[Capacity] = {};
+    std::size_t size_ = 0;
+    // Multiplies the result by prime^exponent.
+    LIBCPPRIME_CONSTEXPR void add(const std::uint64_t prime, const std::int32_t exponent) noexcept {
+        std::size_t i = size_;
+        while (i != 0 && factors_[i - 1].prime > prime) --i;
+        if (i != 0 && factors_[i - 1].prime == prime) {
+            factors_[i - 1].exponent += exponent;
+            return;
+        }
+        for (std::size_t j = size_; j != i; --j) factors_[j] = factors_[j - 1];
+        factors_[i] = PrimePower{ prime, exponent };
+        ++size_;
+    }
+    friend class internal::Factorizer;
+
+public:
+    LIBCPPRIME_CONSTEXPR std::size_t size() const noexcept { return size_; }
+    LIBCPPRIME_CONSTEXPR bool empty() const noexcept { return size_ == 0; }
+    LIBCPPRIME_CONSTEXPR const PrimePower& operator[](const std::size_t i) const noexcept { return factors_[i]; }
+    LIBCPPRIME_CONSTEXPR const PrimePower* begin() const noexcept { return factors_; }
+    LIBCPPRIME_CONSTEXPR const PrimePower* end() const noexcept { return factors_ + size_; }
+};
+
+namespace internal {
+
+    // clang-format off
+    // The odd primes below 256, their inverses modulo 2^64 and floor((2^64 - 1) / p).
+    // n is divisible by p if and only if n * inverse <= limit, and then n * inverse is the quotient.
+    constexpr std::uint16_t TrialPrimes[53] = {
+3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107,
+109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223, 227, 229, 233, 239, 241, 251,
+    };
+    constexpr std::uint64_t TrialInverses[53] = {
+0xaaaaaaaaaaaaaaabu, 0xcccccccccccccccdu, 0x6db6db6db6db6db7u, 0x2e8ba2e8ba2e8ba3u, 0x4ec4ec4ec4ec4ec5u, 0xf0f0f0f0f0f0f0f1u,
+0x86bca1af286bca1bu, 0xd37a6f4de9bd37a7u, 0x34f72c234f72c235u, 0xef7bdef7bdef7bdfu, 0x14c1bacf914c1badu, 0x8f9c18f9c18f9c19u,
+0x82fa0be82fa0be83u, 0x51b3bea3677d46cfu, 0x21cfb2b78c13521du, 0xcbeea4e1a08ad8f3u, 0x4fbcda3ac10c9715u, 0xf0b7672a07a44c6bu,
+0x193d4bb7e327a977u, 0x7e3f1f8fc7e3f1f9u, 0x9b8b577e613716afu, 0xa3784a062b2e43dbu, 0xf47e8fd1fa3f47e9u, 0xa3a0fd5c5f02a3a1u,
+0x3a4c0a237c32b16du, 0xdab7ec1dd3431b57u, 0x77a04c8f8d28ac43u, 0xa6c0964fda6c0965u, 0x90fdbc090fdbc091u, 0x7efdfbf7efdfbf7fu,
+0x3e88cb3c9484e2bu, 0xe21a291c077975b9u, 0x3aef6ca970586723u, 0xdf5b0f768ce2cabdu, 0x6fe4dfc9bf937f27u, 0x5b4fe5e92c0685b5u,
+0x1f693a1c451ab30bu, 0x8d07aa27db35a717u, 0x882383b30d516325u, 0xed6866f8d962ae7bu, 0x3454dca410f8ed9du, 0x1d7ca632ee936f3fu,
+0x70bf015390948f41u, 0xc96bdb9d3d137e0du, 0x2697cc8aef46c0f7u, 0xc0e8f2a76e68575bu, 0x687763dfdb43bb1fu, 0x1b10ea929ba144cbu,
+0x1d10c4c0478bbcedu, 0x63fb9aeb1fdcd759u, 0x64afaa4f437b2e0fu, 0xf010fef010fef011u, 0x28cbfbeb9a020a33u,
+    };
+    constexpr std::uint64_t TrialLimits[53] = {
+0x5555555555555555u, 0x3333333333333333u, 0x2492492492492492u, 0x1745d1745d1745d1u, 0x13b13b13b13b13b1u, 0xf0f0f0f0f0f0f0fu,
+0xd79435e50d79435u, 0xb21642c8590b216u, 0x8d3dcb08d3dcb08u, 0x842108421084210u, 0x6eb3e45306eb3e4u, 0x63e7063e7063e70u,
+0x5f417d05f417d05u, 0x572620ae4c415c9u, 0x4d4873ecade304du, 0x456c797dd49c341u, 0x4325c53ef368eb0u, 0x3d226357e16ece5u,
+0x39b0ad12073615au, 0x381c0e070381c0eu, 0x33d91d2a2067b23u, 0x3159721ed7e7534u, 0x2e05c0b81702e05u, 0x2a3a0fd5c5f02a3u,
+0x288df0cac5b3f5du, 0x27c45979c95204fu, 0x2647c69456217ecu, 0x2593f69b02593f6u, 0x243f6f0243f6f02u, 0x204081020408102u,
+0x1f44659e4a42715u, 0x1de5d6e3f8868a4u, 0x1d77b654b82c339u, 0x1b7d6c3dda338b2u, 0x1b2036406c80d90u, 0x1a16d3f97a4b01au,
+0x1920fb49d0e228du, 0x1886e5f0abb0499u, 0x17ad2208e0ecc35u, 0x16e1f76b4337c6cu, 0x16a13cd15372904u, 0x1571ed3c506b39au,
+0x15390948f40feacu, 0x14cab88725af6e7u, 0x149539e3b2d066eu, 0x13698df3de07479u, 0x125e22708092f11u, 0x120b470c67c0d88u,
+0x11e2ef3b3fb8744u, 0x119453808ca29c0u, 0x112358e75d30336u, 0x10fef010fef010fu, 0x105197f7d734041u,
+    };
+    // clang-format on
+
+    // Returns a nontrivial factor of n, which must be odd and composite.
+    // Brent's variant of Pollard's rho, which takes the gcd of n and the product of many differences at once.
+    // Each step waits for a modular squaring, so two sequences with different constants run side by side and the first collision wins.
+    template<bool Strict> LIBCPPRIME_CONSTEXPR std::uint64_t PollardBrent(const std::uint64_t n) noexcept {
+        constexpr std::uint64_t M = 128;
+        const MontgomeryModint64Impl<Strict> mint(n);
+        const std::uint64_t one = mint.one(), two = mint.add(one, one);
+        for (std::uint64_t c = one;; c = mint.add(c, two)) {
+            const std::uint64_t d = mint.add(c, one);
+            std::uint64_t x1 = 0, x2 = 0, y1 = two, y2 = two, ys1 = y1, ys2 = y2, q = one, g = 1;
+            for (std::uint64_t r = 1; g == 1; r <<= 1) {
+                x1 = y1, x2 = y2;
+                for (std::uint64_t i = 0; i != r; ++i) y1 = mint.add(mint.mul(y1, y1), c), y2 = mint.add(mint.mul(y2, y2), d);
+                for (std::uint64_t k = 0; k < r && g == 1; k += M) {
+                    ys1 = y1, ys2 = y2;
+                    for (std::uint64_t i = 0; i != M && i != r - k; ++i) {
+                        y1 = mint.add(mint.mul(y1, y1), c), y2 = mint.add(mint.mul(y2, y2), d);
+                        q = mint.mul(q, mint.mul(mint.sub(x1, y1), mint.sub(x2, y2)));
+                    }
+                    g = GCD(mint.val(q), n);
+                }
+            }
+            // The product reached a multiple of n, so go through the last batch again one difference at a time.
+            if (g == 0 || g == n) {
+                do {
+                    ys1 = mint.add(mint.mul(ys1, ys1), c), ys2 = mint.add(mint.mul(ys2, ys2), d);
+                    g = GCD(mint.val(mint.sub(x1, ys1)), n);
+                    if (g == 1) g = GCD(mint.val(mint.sub(x2, ys2)), n);
+                } while (g == 1);
+            }
+            // Otherwise both sequences met modulo every prime factor at once, so start over with other polynomials.
+            if (g != 0 && g != n) return g;
+        }
+    }
+
+    class Factorizer {
+    public:
+        static LIBCPPRIME_CONSTEXPR FactorizeResult Run(std::uint64_t n) noexcept {
+            FactorizeResult res;
+            if (n <= 1) return res;
+            const std::int32_t twos = CountrZero(n);
+            if (twos != 0) res.add(2, twos), n >>= twos;
+            for (std::int32_t i = 0; i != 53; ++i) {
+                const std::uint64_t p = TrialPrimes[i];
+                if (n < p * p) {
+                    if (n != 1) res.add(n, 1);
+                    return res;
+                }
+                if (n * TrialInverses[i] <= TrialLimits[i]) {
+                    std::int32_t e = 0;
+                    do {
+                        n *= TrialInverses[i];
+                        ++e;
+                    } while (n * TrialInverses[i] <= TrialLimits[i]);
+                    res.add(p, e);
+                }
+            }
+            // What is left has no prime factor below 256, so it has at most 7 prime factors.
+            std::uint64_t stack[8] = {};
+            std::int32_t size = 0;
+            if (n != 1) stack[size++] = n;
+            while (size != 0) {
+                const std::uint64_t m = stack[--size];
+                if (cppr::IsPrime(m)) {
+                    res.add(m, 1);
+                    continue;
+                }
+                const std::uint64_t d = m < (1ull << 62) ? PollardBrent<false>(m) : PollardBrent<true>(m);
+                stack[size++] = d;
+                stack[size++] = m / d;
+            }
+            return res;
+        }
+    };
+
+}  // namespace internal
+
+// Returns the prime factorization of n, with the primes in increasing order. It is empty for n = 0 and n = 1.
+LIBCPPRIME_CONSTEXPR FactorizeResult Factorize(std::uint64_t n) noexcept {
+    return internal::Factorizer::Run(n);
+}
+
+}  // namespace cppr
+
+#endif
@@ -43,6 +43,7 @@
 **/
 
 #include "./internal/IsPrimeCommon.hpp"
+#include "./internal/IsPrimeSimd.hpp"
 
 #ifndef LIBCPPRIME_INCLUDED_IS_PRIME
 #define LIBCPPRIME_INCLUDED_IS_PRIME
@@ -72,6 +73,7 @@ namespace internal {
     };
     // clang-format on
     LIBCPPRIME_CONSTEXPR bool IsPrime16(const std::uint64_t n) noexcept {
+        LIBCPPRIME_STATS_TIER(Table16);
         return n == 2 || (n % 2 == 1 && (FlagTable16[n / 128] & (1ull << (n % 128 / 2))));
     }
 
@@ -238,12 +240,18 @@ namespace internal {
 206,119,3406,6754,309,3909,646,3677,3514,8797,1435,301,9215,3730,7282,165,3381,303,6369,2627,115,761,3695,1233,1297,1803,1130,122,511,58,6426,1389,1433,9102,943,2795,13162,9905,899,9740,8719,517,5115,4977,1486,8259,7163,13549,7561,305,119,973,7698,5619,5326,5772,32611,8846,1709,4641,782,2503,3905,4051,4923,165,16132,16827,1913,6590,322,741,522,7666,1655,5087,468,8541,1169,4455,22993,2801,6623,446,1979,10923,3503,32053,523,5721,9608,955,11766,49919,1982,66,3347,9508,439,145,5697,1026,1569
     };
     // clang-format on
-    LIBCPPRIME_CONSTEXPR bool IsPrime64(const std::uint64_t x) noexcept {
-        const MontgomeryModint64Impl<true> mint(x);
+    LIBCPPRIME_CONSTEXPR std::uint64_t ThirdBase64(const std::uint32_t base) noexcept {
+        return ((15ull | (135ull << 8) | (13ull << 16) | (60ull << 24) | (15ull << 32) | (117ull << 40) | (65ull << 48) | (29ull << 56)) >> (8 * (base >> 13))) & 0xff;
+    }
+    // Below 2^62 the lazy Montgomery multiplication can be used, and below 2^49 only two bases are needed.
+    template<std::int32_t Bits = 64> LIBCPPRIME_CONSTEXPR bool IsPrime64(const std::uint64_t x) noexcept {
+        const MontgomeryModint64Impl<(Bits > 62)> mint(x);
         const std::int32_t S = CountrZero(x - 1);
         const std::uint64_t D = (x - 1) >> S;
         const auto one = mint.one(), mone = mint.neg(one);
         auto test2 = [=](std::uint64_t base1, std::uint64_t base2) -> bool {
+            LIBCPPRIME_STATS_TIER(TwoBases64);
+            LIBCPPRIME_STATS_ADD(squarings, 2 * (63 - CountlZero(D)));
             auto c = mint.raw(base1), d = mint.raw(base2);
             auto a = c, b = d;
             if (D != 1) {
@@ -260,6 +268,7 @@ namespace internal {
             bool res1 = mint.same(a, one) || mint.same(a, mone);
             bool res2 = mint.same(b, one) || mint.same(b, mone);
             if (x % 4 == 1 && !(res1 && res2)) {
+                LIBCPPRIME_STATS_ADD(squarings, 2 * (S - 1));
                 for (std::int32_t i = 0; i != S - 1; ++i) {
                     a = mint.mul(a, a), b = mint.mul(b, b);
                     res1 |= mint.same(a, mone), res2 |= mint.same(b, mone);
@@ -268,6 +277,8 @@ namespace internal {
             return res1 && res2;
         };
         auto test3 = [=](std::uint64_t base1, std::uint64_t base2, std::uint64_t base3) -> bool {
+            LIBCPPRIME_STATS_TIER(ThreeBases64);
+            LIBCPPRIME_STATS_ADD(squarings, 3 * (63 - CountlZero(D)));
             auto d = mint.raw(base1), e = mint.raw(base2), f = mint.raw(base3);
             auto a = d, b = e, c = f;
             if (D != 1) {
@@ -285,6 +296,7 @@ namespace internal {
             bool res2 = mint.same(b, one) || mint.same(b, mone);
             bool res3 = mint.same(c, one) || mint.same(c, mone);
             if (x % 4 == 1 && !(res1 && res2 && res3)) {
+                LIBCPPRIME_STATS_ADD(squarings, 3 * (S - 1));
                 for (std::int32_t i = 0; i != S - 1; ++i) {
                     a = mint.mul(a, a), b = mint.mul(b, b), c = mint.mul(c, c);
                     res1 |= mint.same(a, mone), res2 |= mint.same(b, mone), res3 |= mint.same(c, mone);
@@ -293,18 +305,143 @@ namespace internal {
             return res1 && res2 && res3;
         };
         const std::uint32_t base = Bases64[(0xad625b89u * static_cast<std::uint32_t>(x)) >> 18];
-        if (x < (1ull << 49)) return test2(2, base);
-        else return test3(2, base, ((15ull | (135ull << 8) | (13ull << 16) | (60ull << 24) | (15ull << 32) | (117ull << 40) | (65ull << 48) | (29ull << 56)) >> (8 * (base >> 13))) & 0xff);
+        if (Bits <= 49 || x < (1ull << 49)) return test2(2, base);
+        else return test3(2, base, ThirdBase64(base));
+    }
+
+    // The trial division by the primes from 19 to 353 costs less than a Miller-Rabin test and rejects about half of the remaining composites,
+    // but it is pure overhead for primes, so it is only enabled by LIBCPPRIME_TRIAL_DIVISION.
+#ifdef LIBCPPRIME_TRIAL_DIVISION
+    constexpr bool TrialDivisionDefault = true;
+#else
+    constexpr bool TrialDivisionDefault = false;
+#endif
+    template<std::int32_t K> struct MillerRabinQueue {
+        std::uint64_t x[8] = {}, bases[8][K] = {};
+        std::size_t index[8] = {};
+        std::int32_t size = 0;
+        LIBCPPRIME_CONSTEXPR void push(const std::uint64_t v, const std::uint32_t base, const std::size_t i, bool* out) noexcept {
+            x[size] = v, index[size] = i;
+            bases[size][0] = 2, bases[size][1] = base;
+            if LIBCPPRIME_IF_CONSTEXPR (K == 3) bases[size][K - 1] = ThirdBase64(base);
+            if (++size == 8) {
+                LIBCPPRIME_STATS_ADD(tiers[PrimalityStats::Batch64], 8);
+                for (std::int32_t l = 0; l != 8; ++l) LIBCPPRIME_STATS_ADD(squarings, K * (63 - CountlZero((x[l] - 1) >> CountrZero(x[l] - 1))));
+                bool r[8] = {};
+                MillerRabin8<K>(x, bases, r);
+                for (std::int32_t l = 0; l != 8; ++l) out[index[l]] = r[l];
+                size = 0;
+            }
+        }
+        LIBCPPRIME_CONSTEXPR void flush(bool* out) noexcept {
+            for (std::int32_t l = 0; l != size; ++l) out[index[l]] = IsPrime64(x[l]);
+            size = 0;
+        }
+    };
+
+    // IsPrime32 uses a hashed base from 85849, and below that it decides by a GCD, so only larger inputs are queued.
+    constexpr std::uint64_t MillerRabin32Min = 85849;
+    struct MillerRabin32Queue {
+        std::uint32_t x[32] = {}, bases[32] = {};
+        std::size_t index[32] = {};
+        std::int32_t size = 0;
+        LIBCPPRIME_CONSTEXPR void push(const std::uint32_t v, const std::size_t i, bool* out) noexcept {
+            x[size] = v, index[size] = i;
+            bases[size] = Bases[(v * 0xad625b89u) >> 24];
+            if (++size == 32) {
+                LIBCPPRIME_STATS_ADD(tiers[PrimalityStats::Batch32], 32);
+                for (std::int32_t l = 0; l != 32; ++l) LIBCPPRIME_STATS_ADD(squarings, 63 - CountlZero((x[l] - 1) >> CountrZero(x[l] - 1)));
+                bool r[32] = {};
+                MillerRabin32x32(x, bases, r);
+                for (std::int32_t l = 0; l != 32; ++l) out[index[l]] = r[l];
+                size = 0;
+            }
+        }
+        LIBCPPRIME_CONSTEXPR void flush(bool* out) noexcept {
+            for (std::int32_t l = 0; l != size; ++l) out[index[l]] = IsPrime32(x[l]);
+            size = 0;
+        }
+    };
+
+    LIBCPPRIME_CONSTEXPR void IsPrimeBatch(const std::uint64_t* in, std::size_t n, bool* out) noexcept {
+        // Inputs below 2^52 are kept apart from larger ones so that they can use the IFMA kernel.
+        MillerRabin32Queue q32;
+        MillerRabinQueue<2> q49;
+        MillerRabinQueue<3> q52, q64;
+        for (std::size_t i = 0; i != n; ++i) {
+            const std::uint64_t x = in[i];
+            if (x < 65536) out[i] = IsPrime16(x);
+            else if (HasSmallFactor(x)) {
+                LIBCPPRIME_STATS_ADD(small_factor_exits, 1);
+                out[i] = false;
+            } else if (TrialDivisionDefault && HasMediumFactor(x)) {
+                LIBCPPRIME_STATS_ADD(trial_division_exits, 1);
+                out[i] = false;
+            } else if (x < MillerRabin32Min) out[i] = IsPrime32(static_cast<std::uint32_t>(x));
+            else if (x <= 0xffffffff) q32.push(static_cast<std::uint32_t>(x), i, out);
+            else {
+                const std::uint32_t base = Bases64[(0xad625b89u * static_cast<std::uint32_t>(x)) >> 18];
+                if (x < (1ull << 49)) q49.push(x, base, i, out);
+                else if (x < (1ull << 52)) q52.push(x, base, i, out);
+                else q64.push(x, base, i, out);
+            }
+        }
+        q32.flush(out), q49.flush(out), q52.flush(out), q64.flush(out);
+    }
+
+    template<std::int32_t Bits, bool TrialDivision = TrialDivisionDefault> LIBCPPRIME_CONSTEXPR bool IsPrimeBits(const std::uint64_t n) noexcept {
+        // An input of 2^16 or more would read past FlagTable16, so it is reported as not prime.
+        if (Bits <= 16) return (n >> 16) == 0 && IsPrime16(n);
+        if (n < 65536) return IsPrime16(n);
+        else {
+            if (HasSmallFactor(n)) {
+                LIBCPPRIME_STATS_ADD(small_factor_exits, 1);
+                return false;
+            }
+            if (TrialDivision && HasMediumFactor(n)) {
+                LIBCPPRIME_STATS_ADD(trial_division_exits, 1);
+                return false;
+            }
+            if (Bits <= 32 || n <= 0xffffffff) return IsPrime32<(Bits < 32 ? Bits : 32)>(static_cast<std::uint32_t>(n));
+            else return IsPrime64<Bits>(n);
+        }
+    }
+    constexpr std::int32_t BitWidth(const std::uint64_t n) noexcept {
+        return n == 0 ? 0 : 1 + BitWidth(n >> 1);
     }
 
 }  // namespace internal
 
+enum class Range { U16, U32, U49, U62, U64 };
+
+template<Range R> LIBCPPRIME_CONSTEXPR bool IsPrime(std::uint64_t n) noexcept {
+    LIBCPPRIME_STATS_TIMED_RETURN(IsPrimeEntry, (internal::IsPrimeBits<R == Range::U16 ? 16 : R == Range::U32 ? 32 : R == Range::U49 ? 49 : R == Range::U62 ? 62 : 64>(n)));
+}
+
+template<std::uint64_t Bound> LIBCPPRIME_CONSTEXPR bool IsPrimeBelow(std::uint64_t n) noexcept {
+    static_assert(Bound != 0, "the bound must be positive");
+    LIBCPPRIME_STATS_TIMED_RETURN(IsPrimeEntry, internal::IsPrimeBits<internal::BitWidth(Bound - 1)>(n));
+}
+
 LIBCPPRIME_CONSTEXPR bool IsPrime(std::uint64_t n) noexcept {
-    if (n < 65536) return internal::IsPrime16(n);
-    else {
-        if ((n & 1) == 0 || 6148914691236517205u >= 12297829382473034411u * n || 3689348814741910323u >= 14757395258967641293u * n || 2635249153387078802u >= 7905747460161236407u * n || 1676976733973595601u >= 3353953467947191203u * n || 1418980313362273201u >= 5675921253449092805u * n || 1085102592571150095u >= 17361641481138401521u * n) return false;
-        if (n <= 0xffffffff) return internal::IsPrime32(static_cast<std::uint32_t>(n));
-        else return internal::IsPrime64(n);
+    return IsPrime<Range::U64>(n);
+}
+
+LIBCPPRIME_CONSTEXPR void IsPrimeBatch(const std::uint64_t* in, std::size_t n, bool* out) noexcept {
+    internal::IsPrimeBatch(in, n, out);
+}
+
+LIBCPPRIME_CONSTEXPR void IsPrimeBatch(const std::uint64_t* in, std::size_t n, std::uint8_t* out) noexcept {
+    // Only about one input in five passes the check for small factors, so the chunks are large enough to fill the queues of IsPrimeBatch several times.
+    bool tmp[1024] = {};
+    for (std::size_t i = 0; i < n; i += 1024) {
+        const std::size_t m = n - i < 1024 ? n - i : 1024;
+        internal::IsPrimeBatch(in + i, m, tmp);
+        for (std::size_t j = 0; j < m; j += 8) {
+            std::uint8_t bits = 0;
+            for (std::size_t k = 0; k != 8 && j + k != m; ++k) bits |= static_cast<std::uint8_t>(tmp[j + k]) << k;
+            out[(i + j) / 8] = bits;
+        }
     }
 }
 
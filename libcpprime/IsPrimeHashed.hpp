@@ -0,0 +1,90 @@
+/**
+ * libcpprime IsPrimeHashed.hpp https://github.com/Rac75116/libcpprime
+ * 
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+**/
+
+
+#include "./IsPrimeNoTable.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_IS_PRIME_HASHED
+#define LIBCPPRIME_INCLUDED_IS_PRIME_HASHED
+
+namespace cppr {
+
+namespace internal {
+
+    constexpr std::uint16_t HashedBases32x16Data[16] = { 38, 583, 411, 38, 1029, 5, 157, 4921, 183, 854, 93, 159, 1411, 855, 543, 254 };
+
+    template<class Table> LIBCPPRIME_CONSTEXPR bool IsPrimeHashedTable(const std::uint64_t x) noexcept {
+        constexpr std::int32_t K = Table::PerEntry + (Table::Base2 ? 1 : 0);
+        const std::uint32_t h = (static_cast<std::uint32_t>(x) * Table::Multiplier) >> (32 - Table::Bits);
+        std::uint64_t bases[1][K] = {};
+        std::int32_t k = 0;
+        if LIBCPPRIME_IF_CONSTEXPR (Table::Base2) bases[0][k++] = 2;
+        for (std::int32_t i = 0; i != Table::PerEntry; ++i) bases[0][k++] = Table::Base(h * Table::PerEntry + i);
+        bool res = false;
+        MillerRabinInterleaved<1, K>(&x, bases, &res);
+        return res;
+    }
+
+}  // namespace internal
+
+// Tables in the format printed by tools/gen_bases.cpp.
+// For x < Bound, x is prime if and only if it is a strong probable prime to base 2 (if Base2 is true)
+// and to the PerEntry bases stored at Base(h * PerEntry), where h = (uint32(x) * Multiplier) >> (32 - Bits).
+// Every base is below 65536.
+
+// The table used by IsPrime: 256 bases and a single test per input.
+struct HashedBases32x256 {
+    static constexpr std::int32_t Bits = 8, PerEntry = 1;
+    static constexpr std::uint32_t Multiplier = 0xad625b89u;
+    static constexpr std::uint64_t Bound = 4294967296u;
+    static constexpr bool Base2 = false;
+    static constexpr std::uint16_t Base(const std::uint32_t i) noexcept { return internal::Bases[i]; }
+};
+// 16 bases after base 2: 32 bytes of table for one extra test per prime.
+struct HashedBases32x16 {
+    static constexpr std::int32_t Bits = 4, PerEntry = 1;
+    static constexpr std::uint32_t Multiplier = 0xad625b89u;
+    static constexpr std::uint64_t Bound = 4294967296u;
+    static constexpr bool Base2 = true;
+    static constexpr std::uint16_t Base(const std::uint32_t i) noexcept { return internal::HashedBases32x16Data[i]; }
+};
+
+// Inputs at or above Table::Bound are handled as in IsPrimeNoTable.
+template<class Table> LIBCPPRIME_CONSTEXPR bool IsPrimeHashed(const std::uint64_t n) noexcept {
+    static_assert(1 <= Table::Bits && Table::Bits <= 32, "Table::Bits must be in [1, 32]");
+    static_assert(Table::PerEntry >= 1, "Table::PerEntry must be positive");
+    if (n < 1024) return internal::IsPrime10(n);
+    if (internal::HasSmallFactor(n)) return false;
+    if (n < 85849) return internal::IsPrime32<17>(static_cast<std::uint32_t>(n));
+    if (n < Table::Bound) return internal::IsPrimeHashedTable<Table>(n);
+    if (n <= 0xffffffff) return internal::IsPrime32(static_cast<std::uint32_t>(n));
+    else if (n < (std::uint64_t(1) << 62)) return internal::IsPrime64MillerRabin(n);
+    else return internal::IsPrime64BailliePSW(n);
+}
+
+}  // namespace cppr
+
+#endif
@@ -29,146 +29,188 @@
 #ifndef LIBCPPRIME_INCLUDED_IS_PRIME_NO_TABLE
 #define LIBCPPRIME_INCLUDED_IS_PRIME_NO_TABLE
 
+#include <cmath>
+
 namespace cppr {
 
 namespace internal {
 
     constexpr std::uint32_t FlagTable10[32] = { 0xa08a28acu, 0x28208a20u, 0x2088288u, 0x800228a2u, 0x20a00a08u, 0x80282088u, 0x800800a2u, 0x8028228u, 0xa20a082u, 0x22880020u, 0x28020800u, 0x88208082u, 0x2022020u, 0x8828028u, 0x8008a202u, 0x20880880u, 0x20000a00u, 0xa082008u, 0x82820802u, 0x800a20u, 0x28208au, 0x20080822u, 0x20808020u, 0x2208088u, 0x20080022u, 0x28a00a00u, 0x8a200080u, 0x8a2000u, 0x808800u, 0x2082202u, 0x80820880u, 0x28220020u };
     LIBCPPRIME_CONSTEXPR bool IsPrime10(const std::uint64_t n) noexcept {
+        LIBCPPRIME_STATS_TIER(Table10);
         return (FlagTable10[n / 32] >> (n % 32)) & 1;
     }
 
-    LIBCPPRIME_CONSTEXPR std::uint64_t GetLucasBase(const std::uint64_t x) noexcept {
-        std::uint32_t tmp = x % 5;
-        if (tmp == 2 || tmp == 3) return 5;
-        tmp = x % 13;
-        if (tmp == 2 || tmp == 5 || tmp == 6 || tmp == 7 || tmp == 8 || tmp == 11) return 13;
-        tmp = x % 17;
-        if (tmp == 3 || tmp == 5 || tmp == 6 || tmp == 7 || tmp == 10 || tmp == 11 || tmp == 12 || tmp == 14) return 17;
-        tmp = x % 21;
-        if (tmp == 2 || tmp == 8 || tmp == 10 || tmp == 11 || tmp == 13 || tmp == 19) return 21;
-        tmp = x % 29;
-        if (tmp == 0) return 0;
-        if (tmp == 2 || tmp == 3 || tmp == 8 || tmp == 10 || tmp == 11 || tmp == 12 || tmp == 14 || tmp == 15 || tmp == 17 || tmp == 18 || tmp == 19 || tmp == 21 || tmp == 26 || tmp == 27) return 29;
-        if (0x02030213u >> (x & 31) & 1) {
-            std::int32_t k = 32 - (CountlZero(x - 1) >> 1);
-            std::uint64_t s = 1ull << k, t = (s + (x >> k)) >> 1;
-            while (t < s) {
-                s = t;
-                t = (s + x / s) >> 1;
+    // The Jacobi symbol (a / n) for odd n, by the binary algorithm without divisions.
+    LIBCPPRIME_CONSTEXPR std::int32_t Jacobi(std::uint64_t a, std::uint64_t n) noexcept {
+        std::uint64_t flip = 0;
+        while (a != 0) {
+            const std::int32_t s = CountrZero(a);
+            a >>= s;
+            flip ^= static_cast<std::uint64_t>(s) & ((n >> 1) ^ (n >> 2)) & 1;
+            if (a < n) {
+                const std::uint64_t t = a;
+                a = n, n = t;
+                flip ^= (a & n) >> 1 & 1;
             }
-            if (s * s == x) return 0;
+            a -= n;
+        }
+        return n != 1 ? 0 : flip ? -1 : 1;
+    }
+
+    // Whether r can be x mod 64 and y x mod 45045 = 63 * 65 * 11 for a square x. Together they reject all but about 1% of the non-squares.
+    LIBCPPRIME_CONSTEXPR bool SquareResidue64(const std::uint32_t r) noexcept { return (0x202021202030213u >> r) & 1; }
+    LIBCPPRIME_CONSTEXPR bool SquareResidue45045(const std::uint32_t y) noexcept {
+        if (!((0x402483012450293u >> (y % 63)) & 1)) return false;
+        const std::uint32_t r = y % 65;
+        if (r != 64 && !((0x218a019866014613u >> r) & 1)) return false;
+        return (0x23bu >> (y % 11)) & 1;
+    }
+
+    LIBCPPRIME_CONSTEXPR bool IsSquare(const std::uint64_t x) noexcept {
+        if (!SquareResidue64(x & 63) || !SquareResidue45045(x % 45045)) return false;
+#ifdef __cpp_lib_is_constant_evaluated
+        if (!std::is_constant_evaluated()) {
+            const std::uint64_t s = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(x)) + 0.5);
+            return s * s == x;
         }
-        std::uint64_t Z = 33;
-        while (Z < x) {
-            std::uint64_t a = Z, n = x;
-            bool res = false;
-            while (a != 0) {
-                std::int32_t s = CountrZero(a);
-                a >>= s;
-                res ^= ((s & 1) & ((n & 0b111) == 3 || (n & 0b111) == 5));
-                res ^= ((a & 0b11) == 3 && (n & 0b11) == 3);
-                std::uint64_t t = n;
-                n = a;
-                a = t % n;
+#endif
+        const std::uint64_t s = Isqrt(x);
+        return s * s == x;
+    }
+
+    // The operations on the number under test that GetLucasBase and StrongLucasTest need.
+    // They are specialized for std::uint64_t here and for unsigned __int128 in IsPrime128.hpp, so both widths share one Baillie-PSW.
+    template<class T> struct BailliePSWOps;
+    constexpr std::uint64_t LucasReciprocal[64] = { 0xffffffffffffffffu / 33, 0xffffffffffffffffu / 37, 0xffffffffffffffffu / 41, 0xffffffffffffffffu / 45, 0xffffffffffffffffu / 49, 0xffffffffffffffffu / 53, 0xffffffffffffffffu / 57, 0xffffffffffffffffu / 61, 0xffffffffffffffffu / 65, 0xffffffffffffffffu / 69, 0xffffffffffffffffu / 73, 0xffffffffffffffffu / 77, 0xffffffffffffffffu / 81, 0xffffffffffffffffu / 85, 0xffffffffffffffffu / 89, 0xffffffffffffffffu / 93, 0xffffffffffffffffu / 97, 0xffffffffffffffffu / 101, 0xffffffffffffffffu / 105, 0xffffffffffffffffu / 109, 0xffffffffffffffffu / 113, 0xffffffffffffffffu / 117, 0xffffffffffffffffu / 121, 0xffffffffffffffffu / 125, 0xffffffffffffffffu / 129, 0xffffffffffffffffu / 133, 0xffffffffffffffffu / 137, 0xffffffffffffffffu / 141, 0xffffffffffffffffu / 145, 0xffffffffffffffffu / 149, 0xffffffffffffffffu / 153, 0xffffffffffffffffu / 157, 0xffffffffffffffffu / 161, 0xffffffffffffffffu / 165, 0xffffffffffffffffu / 169, 0xffffffffffffffffu / 173, 0xffffffffffffffffu / 177, 0xffffffffffffffffu / 181, 0xffffffffffffffffu / 185, 0xffffffffffffffffu / 189, 0xffffffffffffffffu / 193, 0xffffffffffffffffu / 197, 0xffffffffffffffffu / 201, 0xffffffffffffffffu / 205, 0xffffffffffffffffu / 209, 0xffffffffffffffffu / 213, 0xffffffffffffffffu / 217, 0xffffffffffffffffu / 221, 0xffffffffffffffffu / 225, 0xffffffffffffffffu / 229, 0xffffffffffffffffu / 233, 0xffffffffffffffffu / 237, 0xffffffffffffffffu / 241, 0xffffffffffffffffu / 245, 0xffffffffffffffffu / 249, 0xffffffffffffffffu / 253, 0xffffffffffffffffu / 257, 0xffffffffffffffffu / 261, 0xffffffffffffffffu / 265, 0xffffffffffffffffu / 269, 0xffffffffffffffffu / 273, 0xffffffffffffffffu / 277, 0xffffffffffffffffu / 281, 0xffffffffffffffffu / 285 };
+    template<> struct BailliePSWOps<std::uint64_t> {
+        // x mod Z, by a multiplication by floor((2^64 - 1) / Z) for Z = 33, 37, ..., 285, the first 64 Z of the search.
+        static LIBCPPRIME_CONSTEXPR std::uint64_t Mod(const std::uint64_t x, const std::uint64_t Z) noexcept {
+            if (Z >= 33 + 4 * 64) return x % Z;
+            const std::uint64_t r = x - Z * Mulu128High(x, LucasReciprocal[(Z - 33) / 4]);
+            return r >= Z ? r - Z : r;
+        }
+        static LIBCPPRIME_CONSTEXPR bool IsSquare(const std::uint64_t x) noexcept { return internal::IsSquare(x); }
+        static LIBCPPRIME_CONSTEXPR std::int32_t CountrZero(const std::uint64_t x) noexcept { return internal::CountrZero(x); }
+        static LIBCPPRIME_CONSTEXPR std::int32_t BitWidth(const std::uint64_t x) noexcept { return 64 - internal::CountlZero(x); }
+    };
+
+    // The first D of 5, -7, 9, -11, ... with (D / x) = -1, as |D|. Returns 0 if x is a square or has a factor among them, and 1 if D reached x.
+    // The first five candidates are tested by the masks of their non-residues on one residue modulo 672945 = 5 * 13 * 17 * 21 * 29.
+    template<class T> LIBCPPRIME_CONSTEXPR std::uint64_t GetLucasBaseImpl(const T x) noexcept {
+        const std::uint32_t y = static_cast<std::uint32_t>(BailliePSWOps<T>::Mod(x, 672945));
+        if ((0xcu >> (y % 5)) & 1) return 5;
+        if ((0x9e4u >> (y % 13)) & 1) return 13;
+        if ((0x5ce8u >> (y % 17)) & 1) return 17;
+        if ((0x82d04u >> (y % 21)) & 1) return 21;
+        const std::uint32_t tmp = y % 29;
+        if (tmp == 0) return 0;
+        if ((0xc2edd0cu >> tmp) & 1) return 29;
+        if (BailliePSWOps<T>::IsSquare(x)) return 0;
+        // Every Z is 1 mod 4, so (Z / x) = (x / Z).
+        for (std::uint64_t Z = 33; Z < x; Z += 4)
+            if (Jacobi(BailliePSWOps<T>::Mod(x, Z), Z) == -1) return Z;
+        return 1;
+    }
+    LIBCPPRIME_CONSTEXPR std::uint64_t GetLucasBase(const std::uint64_t x) noexcept { return GetLucasBaseImpl<std::uint64_t>(x); }
+
+    // The Miller-Rabin test to the K bases, which are reduced modulo the modulus of mint, with the exponentiations sharing one pass of PowShared.
+    template<std::int32_t K> LIBCPPRIME_CONSTEXPR bool MillerRabinShared(const MontgomeryModint64Impl<false>& mint, const std::int32_t S, const std::uint64_t D, const std::uint64_t* bases) noexcept {
+        const auto one = mint.one(), mone = mint.neg(one);
+        std::uint64_t a[K] = {};
+        for (std::int32_t k = 0; k != K; ++k) a[k] = mint.build(bases[k]);
+        PowShared<K>(mint, D, a, a);
+        bool ok[K] = {}, all = true;
+        for (std::int32_t k = 0; k != K; ++k) {
+            ok[k] = mint.same(a[k], one) || mint.same(a[k], mone);
+            all &= ok[k];
+        }
+        if (all) return true;
+        LIBCPPRIME_STATS_ADD(squarings, K * (S - 1));
+        for (std::int32_t i = 0; i != S - 1; ++i) {
+            for (std::int32_t k = 0; k != K; ++k) {
+                a[k] = mint.mul(a[k], a[k]);
+                ok[k] |= mint.same(a[k], mone);
             }
-            if (n == 1 && res) break;
-            Z += 4;
         }
-        if (Z >= x) return 1;
-        return Z;
+        for (std::int32_t k = 0; k != K; ++k)
+            if (!ok[k]) return false;
+        return true;
     }
 
     LIBCPPRIME_CONSTEXPR bool IsPrime64MillerRabin(const std::uint64_t x) noexcept {
+        LIBCPPRIME_STATS_TIER(MillerRabinNoTable);
         const MontgomeryModint64Impl<false> mint(x);
         const std::int32_t S = CountrZero(x - 1);
         const std::uint64_t D = (x - 1) >> S;
-        const auto one = mint.one(), mone = mint.neg(one);
-        auto test2 = [=](std::uint64_t base1, std::uint64_t base2) -> bool {
-            auto a = one, b = one;
-            auto c = mint.build(base1), d = mint.build(base2);
-            std::uint64_t ex = D;
-            while (ex != 1) {
-                auto e = mint.mul(c, c), f = mint.mul(d, d);
-                if (ex & 1) a = mint.mul(a, c), b = mint.mul(b, d);
-                c = e, d = f;
-                ex >>= 1;
-            }
-            a = mint.mul(a, c), b = mint.mul(b, d);
-            bool res1 = mint.same(a, one) || mint.same(a, mone);
-            bool res2 = mint.same(b, one) || mint.same(b, mone);
-            if (!(res1 && res2)) {
-                for (std::int32_t i = 0; i != S - 1; ++i) {
-                    a = mint.mul(a, a), b = mint.mul(b, b);
-                    res1 |= mint.same(a, mone), res2 |= mint.same(b, mone);
-                }
-                if (!res1 || !res2) return false;
-            }
-            return true;
-        };
-        auto test3 = [=](std::uint64_t base1, std::uint64_t base2, std::uint64_t base3) -> bool {
-            auto a = one, b = one, c = one;
-            auto d = mint.build(base1), e = mint.build(base2), f = mint.build(base3);
-            std::uint64_t ex = D;
-            while (ex != 1) {
-                const auto g = mint.mul(d, d), h = mint.mul(e, e), i = mint.mul(f, f);
-                if (ex & 1) a = mint.mul(a, d), b = mint.mul(b, e), c = mint.mul(c, f);
-                d = g, e = h, f = i;
-                ex >>= 1;
-            }
-            a = mint.mul(a, d), b = mint.mul(b, e), c = mint.mul(c, f);
-            bool res1 = mint.same(a, one) || mint.same(a, mone);
-            bool res2 = mint.same(b, one) || mint.same(b, mone);
-            bool res3 = mint.same(c, one) || mint.same(c, mone);
-            if (!(res1 && res2 && res3)) {
-                for (std::int32_t i = 0; i != S - 1; ++i) {
-                    a = mint.mul(a, a), b = mint.mul(b, b), c = mint.mul(c, c);
-                    res1 |= mint.same(a, mone), res2 |= mint.same(b, mone), res3 |= mint.same(c, mone);
+        // These bases were discovered by Steve Worley and Jim Sinclair.
+        if (x < 585226005592931977ull) {
+            if (x < 7999252175582851ull) {
+                if (x < 350269456337ull) {
+                    const std::uint64_t bases[] = { 4230279247111683200ull, 14694767155120705706ull, 16641139526367750375ull };
+                    return MillerRabinShared<3>(mint, S, D, bases);
+                } else if (x < 55245642489451ull) {
+                    const std::uint64_t bases1[] = { 2ull, 141889084524735ull }, bases2[] = { 1199124725622454117ull, 11096072698276303650ull };
+                    return MillerRabinShared<2>(mint, S, D, bases1) && MillerRabinShared<2>(mint, S, D, bases2);
+                } else {
+                    const std::uint64_t bases1[] = { 2ull, 4130806001517ull }, bases2[] = { 149795463772692060ull, 186635894390467037ull, 3967304179347715805ull };
+                    return MillerRabinShared<2>(mint, S, D, bases1) && MillerRabinShared<3>(mint, S, D, bases2);
                 }
-                if (!res1 || !res2 || !res3) return false;
+            } else {
+                const std::uint64_t bases1[] = { 2ull, 123635709730000ull, 9233062284813009ull }, bases2[] = { 43835965440333360ull, 761179012939631437ull, 1263739024124850375ull };
+                return MillerRabinShared<3>(mint, S, D, bases1) && MillerRabinShared<3>(mint, S, D, bases2);
             }
-            return true;
-        };
-        auto test4 = [=](std::uint64_t base1, std::uint64_t base2, std::uint64_t base3, std::uint64_t base4) -> bool {
-            auto a = one, b = one, c = one, d = one;
-            auto e = mint.build(base1), f = mint.build(base2), g = mint.build(base3), h = mint.build(base4);
-            std::uint64_t ex = D;
-            while (ex != 1) {
-                auto i = mint.mul(e, e), j = mint.mul(f, f), k = mint.mul(g, g), l = mint.mul(h, h);
-                if (ex & 1) a = mint.mul(a, e), b = mint.mul(b, f), c = mint.mul(c, g), d = mint.mul(d, h);
-                e = i, f = j, g = k, h = l;
-                ex >>= 1;
+        } else {
+            const std::uint64_t bases1[] = { 2ull, 325ull, 9375ull }, bases2[] = { 28178ull, 450775ull, 9780504ull, 1795265022ull };
+            return MillerRabinShared<3>(mint, S, D, bases1) && MillerRabinShared<4>(mint, S, D, bases2);
+        }
+    }
+
+    // The strong Lucas test with P = 1 and Q = (1 - D) / 4 on V alone, which needs no halving: V_2k = V_k^2 - 2Q^k and V_2k+1 = V_k * V_k+1 - Q^k.
+    // U_d = 0 is checked as 2 * V_d+1 = V_d, since D * U_d = 2 * V_d+1 - V_d and D is coprime to x. x is the modulus of mint, of either width.
+    template<class Mint> LIBCPPRIME_CONSTEXPR bool StrongLucasTest(const Mint& mint, const std::uint64_t D) noexcept {
+        typedef decltype(mint.mod()) T;
+        typedef decltype(mint.one()) U;
+        const T x = mint.mod();
+        const std::int32_t S = BailliePSWOps<T>::CountrZero(x + 1);
+        const T d = (x + 1) >> S;
+        const U one = mint.one(), Q = mint.raw(x - (D - 1) / 4);
+        U v0 = one, v1 = mint.sub(one, mint.add(Q, Q)), Qk = Q;
+        LIBCPPRIME_STATS_ADD(squarings, BailliePSWOps<T>::BitWidth(d) - 1);
+        for (std::int32_t i = BailliePSWOps<T>::BitWidth(d) - 2; i >= 0; --i) {
+            const U vm = mint.sub(mint.mul(v0, v1), Qk), Q2k = mint.mul(Qk, Qk);
+            if ((d >> i) & 1) {
+                const U Qk1 = mint.mul(Qk, Q);
+                v0 = vm;
+                v1 = mint.sub(mint.mul(v1, v1), mint.add(Qk1, Qk1));
+                Qk = mint.mul(Q2k, Q);
+            } else {
+                v0 = mint.sub(mint.mul(v0, v0), mint.add(Qk, Qk));
+                v1 = vm;
+                Qk = Q2k;
             }
-            a = mint.mul(a, e), b = mint.mul(b, f), c = mint.mul(c, g), d = mint.mul(d, h);
-            bool res1 = mint.same(a, one) || mint.same(a, mone);
-            bool res2 = mint.same(b, one) || mint.same(b, mone);
-            bool res3 = mint.same(c, one) || mint.same(c, mone);
-            bool res4 = mint.same(d, one) || mint.same(d, mone);
-            if (!(res1 && res2 && res3 && res4)) {
-                for (std::int32_t i = 0; i != S - 1; ++i) {
-                    a = mint.mul(a, a), b = mint.mul(b, b), c = mint.mul(c, c), d = mint.mul(d, d);
-                    res1 |= mint.same(a, mone), res2 |= mint.same(b, mone), res3 |= mint.same(c, mone), res4 |= mint.same(d, mone);
-                }
-                if (!res1 || !res2 || !res3 || !res4) return false;
+        }
+        if (mint.is_zero(v0) || mint.same(mint.add(v1, v1), v0)) return true;
+        for (std::int32_t i = 0; i != S; ++i) {
+            v0 = mint.sub(mint.mul(v0, v0), mint.add(Qk, Qk));
+            if (mint.is_zero(v0)) {
+                LIBCPPRIME_STATS_ADD(squarings, i + 1);
+                return true;
             }
-            return true;
-        };
-        // These bases were discovered by Steve Worley and Jim Sinclair.
-        if (x < 585226005592931977ull) {
-            if (x < 7999252175582851ull) {
-                if (x < 350269456337ull) return test3(4230279247111683200ull, 14694767155120705706ull, 16641139526367750375ull);
-                else if (x < 55245642489451ull) return test2(2ull, 141889084524735ull) && test2(1199124725622454117ull, 11096072698276303650ull);
-                else return test2(2ull, 4130806001517ull) && test3(149795463772692060ull, 186635894390467037ull, 3967304179347715805ull);
-            } else return test3(2ull, 123635709730000ull, 9233062284813009ull) && test3(43835965440333360ull, 761179012939631437ull, 1263739024124850375ull);
-        } else return test3(2ull, 325ull, 9375ull) && test4(28178ull, 450775ull, 9780504ull, 1795265022ull);
+            Qk = mint.mul(Qk, Qk);
+        }
+        LIBCPPRIME_STATS_ADD(squarings, S);
+        return false;
     }
 
     LIBCPPRIME_CONSTEXPR bool IsPrime64BailliePSW(const std::uint64_t x) noexcept {
+        LIBCPPRIME_STATS_TIER(BailliePSW);
         const MontgomeryModint64Impl<true> mint(x);
         const auto one = mint.one(), mone = mint.neg(one);
         auto miller_rabin_test = [&]() -> bool {
             const std::int32_t S = CountrZero(x - 1);
             const std::uint64_t D = (x - 1) >> S;
+            LIBCPPRIME_STATS_ADD(squarings, 63 - CountlZero(D));
             auto a = one, b = mint.raw(2);
             std::uint64_t ex = D;
             while (ex != 1) {
@@ -183,53 +225,42 @@ namespace internal {
             if (flag) return true;
             for (std::int32_t i = 0; i != S - 1; ++i) {
                 a = mint.mul(a, a);
-                if (mint.same(a, mone)) return true;
+                if (mint.same(a, mone)) {
+                    LIBCPPRIME_STATS_ADD(squarings, i + 1);
+                    return true;
+                }
             }
+            LIBCPPRIME_STATS_ADD(squarings, S - 1);
             return false;
         };
         if (!miller_rabin_test()) return false;
-        std::uint64_t D = GetLucasBase(x);
+        LIBCPPRIME_STATS_TIER(Lucas);
+        const std::uint64_t D = GetLucasBase(x);
         if (D <= 1) return D == 1;
-        const std::uint64_t Q = mint.raw(x - (D - 1) / 4);
-        std::uint64_t u = one, v = one, Qn = Q;
-        std::uint64_t k = (x + 1) << CountlZero(x + 1);
-        D = mint.raw(D);
-        std::uint64_t t = (x >> 1) + 1;
-        for (k <<= 1; k; k <<= 1) {
-            std::uint64_t Qt = mint.add(Qn, Qn);
-            Qn = mint.mul(Qn, Qn);
-            u = mint.mul(u, v);
-            v = mint.sub(mint.mul(v, v), Qt);
-            if (k >> 63) {
-                Qn = mint.mul(Qn, Q);
-                std::uint64_t uu = u;
-                u = mint.add(u, v);
-                u = (u >> 1) + ((u & 1) ? t : 0);
-                v = mint.add(mint.mul(D, uu), v);
-                v = (v >> 1) + ((v & 1) ? t : 0);
+        return StrongLucasTest(mint, D);
+    }
+
+}  // namespace internal
+
+namespace internal {
+
+    LIBCPPRIME_CONSTEXPR bool IsPrimeNoTable(const std::uint64_t n) noexcept {
+        if (n < 1024) return IsPrime10(n);
+        else {
+            if (HasSmallFactor(n)) {
+                LIBCPPRIME_STATS_ADD(small_factor_exits, 1);
+                return false;
             }
+            if (n <= 0xffffffff) return IsPrime32(static_cast<std::uint32_t>(n));
+            else if (n < (std::uint64_t(1) << 62)) return IsPrime64MillerRabin(n);
+            else return IsPrime64BailliePSW(n);
         }
-        if (mint.is_zero(u) || mint.is_zero(v)) return true;
-        std::uint64_t f = (x + 1) & ~x;
-        for (f >>= 1; f; f >>= 1) {
-            u = mint.mul(u, v);
-            v = mint.sub(mint.mul(v, v), mint.add(Qn, Qn));
-            if (mint.is_zero(v)) return true;
-            Qn = mint.mul(Qn, Qn);
-        }
-        return false;
     }
 
 }  // namespace internal
 
 LIBCPPRIME_CONSTEXPR bool IsPrimeNoTable(std::uint64_t n) noexcept {
-    if (n < 1024) return internal::IsPrime10(n);
-    else {
-        if ((n & 1) == 0 || 6148914691236517205u >= 12297829382473034411u * n || 3689348814741910323u >= 14757395258967641293u * n || 2635249153387078802u >= 7905747460161236407u * n || 1676976733973595601u >= 3353953467947191203u * n || 1418980313362273201u >= 5675921253449092805u * n || 1085102592571150095u >= 17361641481138401521u * n) return false;
-        if (n <= 0xffffffff) return internal::IsPrime32(static_cast<std::uint32_t>(n));
-        else if (n < (std::uint64_t(1) << 62)) return internal::IsPrime64MillerRabin(n);
-        else return internal::IsPrime64BailliePSW(n);
-    }
+    LIBCPPRIME_STATS_TIMED_RETURN(IsPrimeNoTableEntry, internal::IsPrimeNoTable(n));
 }
 
 }  // namespace cppr
@@ -0,0 +1,136 @@
+/**
+ * libcpprime Montgomery.hpp https://github.com/Rac75116/libcpprime
+ * 
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+**/
+
+
+#include "./internal/IsPrimeCommon.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_MONTGOMERY
+#define LIBCPPRIME_INCLUDED_MONTGOMERY
+
+namespace cppr {
+
+namespace internal {
+
+    // These are written as single return statements so that they are constant expressions in C++11.
+    constexpr std::uint64_t MontgomeryInverse(const std::uint64_t n, const std::uint64_t x = 0, const std::int32_t i = 6) noexcept {
+        return i == 6 ? MontgomeryInverse(n, n, 5) : i == 0 ? x : MontgomeryInverse(n, x * (2 - n * x), i - 1);
+    }
+    constexpr std::uint64_t MontgomeryDouble(const std::uint64_t n, const std::uint64_t x, const std::int32_t i) noexcept {
+        return i == 0 ? x : MontgomeryDouble(n, x >= n - x ? x - (n - x) : x + x, i - 1);
+    }
+
+    template<class Derived, bool Strict> class Montgomery64Interface {
+        LIBCPPRIME_CONSTEXPR MontgomeryModint64Impl<Strict> impl() const noexcept { return static_cast<const Derived&>(*this).impl(); }
+
+    public:
+        LIBCPPRIME_CONSTEXPR std::uint64_t mod() const noexcept { return impl().mod(); }
+        LIBCPPRIME_CONSTEXPR std::uint64_t build(const std::uint64_t x) const noexcept { return impl().build(x); }
+        LIBCPPRIME_CONSTEXPR std::uint64_t val(const std::uint64_t x) const noexcept { return impl().val(x); }
+        LIBCPPRIME_CONSTEXPR std::uint64_t one() const noexcept { return impl().one(); }
+        LIBCPPRIME_CONSTEXPR std::uint64_t neg(const std::uint64_t x) const noexcept { return impl().neg(x); }
+        LIBCPPRIME_CONSTEXPR std::uint64_t add(const std::uint64_t x, const std::uint64_t y) const noexcept { return impl().add(x, y); }
+        LIBCPPRIME_CONSTEXPR std::uint64_t sub(const std::uint64_t x, const std::uint64_t y) const noexcept { return impl().sub(x, y); }
+        LIBCPPRIME_CONSTEXPR std::uint64_t mul(const std::uint64_t x, const std::uint64_t y) const noexcept { return impl().mul(x, y); }
+        LIBCPPRIME_CONSTEXPR bool same(const std::uint64_t x, const std::uint64_t y) const noexcept { return impl().same(x, y); }
+        LIBCPPRIME_CONSTEXPR bool is_zero(const std::uint64_t x) const noexcept { return impl().is_zero(x); }
+
+        LIBCPPRIME_CONSTEXPR void mul(const std::uint64_t* x, const std::uint64_t* y, std::uint64_t* out, const std::size_t n) const noexcept {
+            const auto mint = impl();
+            for (std::size_t i = 0; i != n; ++i) out[i] = mint.mul(x[i], y[i]);
+        }
+        LIBCPPRIME_CONSTEXPR std::uint64_t pow(std::uint64_t x, std::uint64_t ex) const noexcept {
+            const auto mint = impl();
+            if (ex == 0) return mint.one();
+            std::uint64_t res = mint.one();
+            while (ex != 1) {
+                const std::uint64_t sq = mint.mul(x, x);
+                if (ex & 1) res = mint.mul(res, x);
+                x = sq;
+                ex >>= 1;
+            }
+            return mint.mul(res, x);
+        }
+        // The K chains are independent, so their multiplications overlap and K bases cost far less than K calls.
+        template<std::size_t K> LIBCPPRIME_CONSTEXPR void pow(const std::uint64_t (&x)[K], std::uint64_t ex, std::uint64_t (&out)[K]) const noexcept {
+            const auto mint = impl();
+            std::uint64_t base[K] = {};
+            for (std::size_t i = 0; i != K; ++i) base[i] = x[i], out[i] = mint.one();
+            if (ex == 0) return;
+            while (ex != 1) {
+                std::uint64_t sq[K] = {};
+                for (std::size_t i = 0; i != K; ++i) sq[i] = mint.mul(base[i], base[i]);
+                if (ex & 1)
+                    for (std::size_t i = 0; i != K; ++i) out[i] = mint.mul(out[i], base[i]);
+                for (std::size_t i = 0; i != K; ++i) base[i] = sq[i];
+                ex >>= 1;
+            }
+            for (std::size_t i = 0; i != K; ++i) out[i] = mint.mul(out[i], base[i]);
+        }
+        LIBCPPRIME_CONSTEXPR std::uint64_t inv(const std::uint64_t x) const noexcept {
+            const auto mint = impl();
+            const std::uint64_t n = mint.mod();
+            // The coefficients of the extended Euclidean algorithm alternate in sign, so only their absolute values are kept.
+            std::uint64_t a = n, b = mint.val(x), s = 0, t = 1;
+            bool positive = false;
+            while (b != 0) {
+                const std::uint64_t q = a / b;
+                const std::uint64_t r = a - q * b, u = s + q * t;
+                a = b, b = r, s = t, t = u;
+                positive = !positive;
+            }
+            if (a != 1) return 0;
+            return mint.raw(positive ? s : n - s);
+        }
+    };
+
+}  // namespace internal
+
+template<bool Strict = false> class Montgomery64 : public internal::Montgomery64Interface<Montgomery64<Strict>, Strict> {
+    internal::MontgomeryModint64Impl<Strict> mint_;
+    LIBCPPRIME_CONSTEXPR const internal::MontgomeryModint64Impl<Strict>& impl() const noexcept { return mint_; }
+    friend class internal::Montgomery64Interface<Montgomery64<Strict>, Strict>;
+
+public:
+    Montgomery64() = default;
+    LIBCPPRIME_CONSTEXPR explicit Montgomery64(const std::uint64_t mod) noexcept : mint_(mod) {}
+};
+
+template<std::uint64_t Mod, bool Strict = false> class StaticMontgomery64 : public internal::Montgomery64Interface<StaticMontgomery64<Mod, Strict>, Strict> {
+    static_assert(Mod > 2 && Mod % 2 == 1, "the modulus must be odd and greater than 2");
+    static_assert(Strict || Mod < (std::uint64_t(1) << 62), "the modulus must be less than 2^62 unless Strict is true");
+    static constexpr std::uint64_t R1 = (0 - Mod) % Mod;
+    static constexpr std::uint64_t R2 = internal::MontgomeryDouble(Mod, R1, 64);
+    static constexpr std::uint64_t Inv = internal::MontgomeryInverse(Mod);
+    constexpr internal::MontgomeryModint64Impl<Strict> impl() const noexcept { return internal::MontgomeryModint64Impl<Strict>(Mod, R2, Inv, R1); }
+    friend class internal::Montgomery64Interface<StaticMontgomery64<Mod, Strict>, Strict>;
+
+public:
+    constexpr StaticMontgomery64() noexcept {}
+};
+
+}  // namespace cppr
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * libcpprime NextPrime.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#include "./IsPrime.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_NEXT_PRIME
+#define LIBCPPRIME_INCLUDED_NEXT_PRIME
+
+namespace cppr {
+
+namespace internal {
+
+    // The residues modulo 210 that are coprime to 210. Wheel210Index[r] is the index of r among them (48 if r is not coprime or r >= 210),
+    // and Wheel210Below[r] is the number of them below r.
+    constexpr std::uint8_t Wheel210[48] = { 1, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 121, 127, 131, 137, 139, 143, 149, 151, 157, 163, 167, 169, 173, 179, 181, 187, 191, 193, 197, 199, 209 };
+    // clang-format off
+    constexpr std::uint8_t Wheel210Index[512] = {
+48, 0, 48, 48, 48, 48, 48, 48, 48, 48, 48, 1, 48, 2, 48, 48, 48, 3, 48, 4, 48, 48, 48, 5, 48, 48, 48, 48, 48, 6, 48, 7,
+48, 48, 48, 48, 48, 8, 48, 48, 48, 9, 48, 10, 48, 48, 48, 11, 48, 48, 48, 48, 48, 12, 48, 48, 48, 48, 48, 13, 48, 14, 48, 48,
+48, 48, 48, 15, 48, 48, 48, 16, 48, 17, 48, 48, 48, 48, 48, 18, 48, 48, 48, 19, 48, 48, 48, 48, 48, 20, 48, 48, 48, 48, 48, 48,
+48, 21, 48, 48, 48, 22, 48, 23, 48, 48, 48, 24, 48, 25, 48, 48, 48, 26, 48, 48, 48, 48, 48, 48, 48, 27, 48, 48, 48, 48, 48, 28,
+48, 48, 48, 29, 48, 48, 48, 48, 48, 30, 48, 31, 48, 48, 48, 32, 48, 48, 48, 48, 48, 33, 48, 34, 48, 48, 48, 48, 48, 35, 48, 48,
+48, 48, 48, 36, 48, 48, 48, 37, 48, 38, 48, 48, 48, 39, 48, 48, 48, 48, 48, 40, 48, 41, 48, 48, 48, 48, 48, 42, 48, 48, 48, 43,
+48, 44, 48, 48, 48, 45, 48, 46, 48, 48, 48, 48, 48, 48, 48, 48, 48, 47, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+    };
+    constexpr std::uint8_t Wheel210Below[211] = {
+0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 3, 3, 3, 3, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6,
+7, 7, 8, 8, 8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 11, 11, 11, 11, 12, 12, 12, 12, 12, 12, 13, 13, 13, 13, 13, 13,
+14, 14, 15, 15, 15, 15, 15, 15, 16, 16, 16, 16, 17, 17, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 20, 20, 20, 20, 20, 20,
+21, 21, 21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 23, 23, 24, 24, 24, 24, 25, 25, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27,
+27, 27, 28, 28, 28, 28, 28, 28, 29, 29, 29, 29, 30, 30, 30, 30, 30, 30, 31, 31, 32, 32, 32, 32, 33, 33, 33, 33, 33, 33,
+34, 34, 35, 35, 35, 35, 35, 35, 36, 36, 36, 36, 36, 36, 37, 37, 37, 37, 38, 38, 39, 39, 39, 39, 40, 40, 40, 40, 40, 40,
+41, 41, 42, 42, 42, 42, 42, 42, 43, 43, 43, 43, 44, 44, 45, 45, 45, 45, 46, 46, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47,
+48,
+    };
+    // The primes from 11 that sieve the candidates of NextPrime and PrevPrime, and floor((2^64 - 1) / p) for each of them.
+    constexpr std::int32_t WindowPrimeCount = 128;
+    constexpr std::uint16_t WindowPrimes[128] = {
+11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151,
+157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223, 227, 229, 233, 239, 241, 251, 257, 263, 269, 271, 277, 281, 283, 293, 307, 311, 313, 317, 331, 337,
+347, 349, 353, 359, 367, 373, 379, 383, 389, 397, 401, 409, 419, 421, 431, 433, 439, 443, 449, 457, 461, 463, 467, 479, 487, 491, 499, 503, 509, 521, 523, 541,
+547, 557, 563, 569, 571, 577, 587, 593, 599, 601, 607, 613, 617, 619, 631, 641, 643, 647, 653, 659, 661, 673, 677, 683, 691, 701, 709, 719, 727, 733, 739, 743,
+    };
+    constexpr std::uint64_t WindowInverses[128] = {
+0x1745d1745d1745d1u, 0x13b13b13b13b13b1u, 0xf0f0f0f0f0f0f0fu, 0xd79435e50d79435u, 0xb21642c8590b216u, 0x8d3dcb08d3dcb08u, 0x842108421084210u, 0x6eb3e45306eb3e4u,
+0x63e7063e7063e70u, 0x5f417d05f417d05u, 0x572620ae4c415c9u, 0x4d4873ecade304du, 0x456c797dd49c341u, 0x4325c53ef368eb0u, 0x3d226357e16ece5u, 0x39b0ad12073615au,
+0x381c0e070381c0eu, 0x33d91d2a2067b23u, 0x3159721ed7e7534u, 0x2e05c0b81702e05u, 0x2a3a0fd5c5f02a3u, 0x288df0cac5b3f5du, 0x27c45979c95204fu, 0x2647c69456217ecu,
+0x2593f69b02593f6u, 0x243f6f0243f6f02u, 0x204081020408102u, 0x1f44659e4a42715u, 0x1de5d6e3f8868a4u, 0x1d77b654b82c339u, 0x1b7d6c3dda338b2u, 0x1b2036406c80d90u,
+0x1a16d3f97a4b01au, 0x1920fb49d0e228du, 0x1886e5f0abb0499u, 0x17ad2208e0ecc35u, 0x16e1f76b4337c6cu, 0x16a13cd15372904u, 0x1571ed3c506b39au, 0x15390948f40feacu,
+0x14cab88725af6e7u, 0x149539e3b2d066eu, 0x13698df3de07479u, 0x125e22708092f11u, 0x120b470c67c0d88u, 0x11e2ef3b3fb8744u, 0x119453808ca29c0u, 0x112358e75d30336u,
+0x10fef010fef010fu, 0x105197f7d734041u, 0xff00ff00ff00ffu, 0xf92fb2211855a8u, 0xf3a0d52cba8723u, 0xf1d48bcee0d399u, 0xec979118f3fc4du, 0xe939651fe2d8d3u,
+0xe79372e225fe30u, 0xdfac1f74346c57u, 0xd578e97c3f5fe5u, 0xd2ba083b445250u, 0xd161543e28e502u, 0xcebcf8bb5b4169u, 0xc5fe740317f9d0u, 0xc2780613c0309eu,
+0xbcdd535db1cc5bu, 0xbbc8408cd63069u, 0xb9a7862a0ff465u, 0xb68d31340e4307u, 0xb2927c29da5519u, 0xafb321a1496fdfu, 0xaceb0f891e6551u, 0xab1cbdd3e2970fu,
+0xa87917088e262bu, 0xa513fd6bb00a51u, 0xa36e71a2cb0331u, 0xa03c1688732b30u, 0x9c69169b30446du, 0x9baade8e4a2f6eu, 0x980e4156201301u, 0x975a750ff68a58u,
+0x9548e4979e0829u, 0x93efd1c50e726bu, 0x91f5bcb8bb02d9u, 0x8f67a1e3fdc261u, 0x8e2917e0e702c6u, 0x8d8be33f95d715u, 0x8c55841c815ed5u, 0x88d180cd3a4133u,
+0x869222b1acf1ceu, 0x85797b917765abu, 0x8355ace3c897dbu, 0x824a4e60b3262bu, 0x80c121b28bd1bau, 0x7dc9f3397d4c29u, 0x7d4ece8fe88139u, 0x79237d65bcce50u,
+0x77cf53c5f7936cu, 0x75a8accfbdd11eu, 0x7467ac557c228eu, 0x732d70ed8db8e9u, 0x72c62a24c3797fu, 0x7194a17f55a10du, 0x6fa549b41da7e7u, 0x6e8419e6f61221u,
+0x6d68b5356c207bu, 0x6d0b803685c01bu, 0x6bf790a8b2d207u, 0x6ae907ef4b96c2u, 0x6a37991a23aeadu, 0x69dfbdd4295b66u, 0x67dc4c45c8033eu, 0x663d80ff99c27fu,
+0x65ec17e3559948u, 0x654ac835cfba5cu, 0x645c854ae10772u, 0x6372990e5f901fu, 0x6325913c07beefu, 0x6160ff9e9f0061u, 0x60cdb520e5e88eu, 0x5ff4017fd005ffu,
+0x5ed79e31a4dccdu, 0x5d7d42d48ac5efu, 0x5c6f35ccba5028u, 0x5b2618ec6ad0a5u, 0x5a2553748e42e7u, 0x59686cf744cd5bu, 0x58ae97bab79976u, 0x58345f1876865fu,
+    };
+    // clang-format on
+
+    LIBCPPRIME_CONSTEXPR std::uint32_t WindowOffset(const std::uint64_t base, const std::int32_t i) noexcept {
+        const std::uint32_t p = WindowPrimes[i];
+        std::uint32_t r = static_cast<std::uint32_t>(base - Mulu128High(base, WindowInverses[i]) * p);
+        r -= p * (r >= p);
+        return r == 0 ? 0 : p - r;
+    }
+    // Marks Hits multiples of each of WindowPrimes[begin, end), starting from the first one in the block.
+    // Hits is a compile-time constant so that the loop over the multiples has no branches; the ones past the block land on bit 48.
+    template<std::uint32_t Hits> LIBCPPRIME_CONSTEXPR std::uint64_t WindowMarks(const std::uint64_t base, const std::int32_t begin, const std::int32_t end) noexcept {
+        std::uint64_t res = 0;
+        for (std::int32_t i = begin; i != end; ++i) {
+            std::uint32_t o = WindowOffset(base, i);
+            for (std::uint32_t k = 0; k != Hits; ++k, o += WindowPrimes[i]) res |= 1ull << Wheel210Index[o];
+        }
+        return res;
+    }
+    // Returns the mask of k < 48 such that base + Wheel210[k] is not divisible by any of WindowPrimes, where base % 210 == 0.
+    LIBCPPRIME_CONSTEXPR std::uint64_t WindowCandidates(const std::uint64_t base) noexcept {
+        // Each group of primes below 210 gets the largest number of multiples any of them can have in a block.
+        std::uint64_t res = WindowMarks<20>(base, 0, 1) | WindowMarks<17>(base, 1, 2) | WindowMarks<13>(base, 2, 4) | WindowMarks<10>(base, 4, 7);
+        res |= WindowMarks<6>(base, 7, 12) | WindowMarks<4>(base, 12, 16) | WindowMarks<3>(base, 16, 24) | WindowMarks<2>(base, 24, 42);
+        // The primes above 210 divide at most one number of the block.
+        for (std::int32_t i = 42; i != WindowPrimeCount; ++i) {
+            const std::uint32_t o = WindowOffset(base, i);
+            res |= static_cast<std::uint64_t>((o - 210) >> 31) << Wheel210Index[o & 255];
+        }
+        return ~res & ((1ull << 48) - 1);
+    }
+
+    // Returns the first prime among base + Wheel210[k] for the bits k of candidates, in increasing order of k if Up and decreasing otherwise,
+    // or 0 if there is none. The numbers must be above 2^32 - 210, and must not be divisible by any of WindowPrimes.
+    template<bool Up> LIBCPPRIME_CONSTEXPR std::uint64_t FirstWindowPrime(const std::uint64_t base, std::uint64_t candidates) noexcept {
+        // A single Miller-Rabin chain is bound by the latency of the multiplications, so four candidates are tested to base 2 at once,
+        // and only those that pass go through the full test.
+        const std::uint64_t bases[4][1] = { { 2 }, { 2 }, { 2 }, { 2 } };
+        while (candidates != 0) {
+            std::uint64_t x[4] = {};
+            std::int32_t n = 0;
+            for (; n != 4 && candidates != 0; ++n) {
+                const std::int32_t k = Up ? CountrZero(candidates) : 63 - CountlZero(candidates);
+                x[n] = base + Wheel210[k];
+                candidates ^= 1ull << k;
+            }
+            for (std::int32_t i = n; i != 4; ++i) x[i] = x[n - 1];
+            bool probable[4] = {};
+            MillerRabinInterleaved<4, 1>(x, bases, probable);
+            for (std::int32_t i = 0; i != n; ++i)
+                if (probable[i] && (x[i] <= 0xffffffff ? IsPrime32(static_cast<std::uint32_t>(x[i])) : IsPrime64(x[i]))) return x[i];
+        }
+        return 0;
+    }
+
+}  // namespace internal
+
+// Returns the smallest prime not less than n, or 0 if there is none below 2^64 (n > 18446744073709551557).
+LIBCPPRIME_CONSTEXPR std::uint64_t NextPrime(std::uint64_t n) noexcept {
+    if (n > 18446744073709551557u) return 0;
+    if (n <= 65521) {
+        while (!internal::IsPrime16(n)) ++n;
+        return n;
+    }
+    // Below 2^32 a test is cheap enough that sieving a window does not pay off, so the candidates only step through the wheel.
+    std::uint64_t base = n - n % 210;
+    if (n <= 4294967291u) {
+        for (std::int32_t i = internal::Wheel210Below[n % 210];; ++i) {
+            if (i == 48) i = 0, base += 210;
+            const std::uint64_t x = base + internal::Wheel210[i];
+            if (!internal::HasSmallFactor(x) && internal::IsPrime32(static_cast<std::uint32_t>(x))) return x;
+        }
+    }
+    // Above it the numbers are sieved 210 at a time. The block of the largest prime below 2^64 ends 16 below 2^64, so nothing overflows.
+    std::uint64_t res = internal::FirstWindowPrime<true>(base, internal::WindowCandidates(base) & (~0ull << internal::Wheel210Below[n % 210]));
+    while (res == 0) {
+        base += 210;
+        res = internal::FirstWindowPrime<true>(base, internal::WindowCandidates(base));
+    }
+    return res;
+}
+
+// Returns the largest prime not greater than n, or 0 if there is none (n < 2).
+LIBCPPRIME_CONSTEXPR std::uint64_t PrevPrime(std::uint64_t n) noexcept {
+    if (n < 65536) {
+        while (n >= 2 && !internal::IsPrime16(n)) --n;
+        return n < 2 ? 0 : n;
+    }
+    std::uint64_t base = n - n % 210;
+    if (n <= 0xffffffff) {
+        for (std::int32_t i = internal::Wheel210Below[n % 210 + 1] - 1;; --i) {
+            if (i == -1) i = 47, base -= 210;
+            const std::uint64_t x = base + internal::Wheel210[i];
+            if (!internal::HasSmallFactor(x) && internal::IsPrime32(static_cast<std::uint32_t>(x))) return x;
+        }
+    }
+    std::uint64_t res = internal::FirstWindowPrime<false>(base, internal::WindowCandidates(base) & ((1ull << internal::Wheel210Below[n % 210 + 1]) - 1));
+    while (res == 0) {
+        base -= 210;
+        res = internal::FirstWindowPrime<false>(base, internal::WindowCandidates(base));
+    }
+    return res;
+}
+
+}  // namespace cppr
+
+#endif
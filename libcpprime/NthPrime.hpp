@@ -0,0 +1,226 @@
+/**
+ * libcpprime NthPrime.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#include "./PrimePi.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_NTH_PRIME
+#define LIBCPPRIME_INCLUDED_NTH_PRIME
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace cppr {
+
+namespace internal {
+
+    // The number of primes below 2^64.
+    constexpr std::uint64_t PrimeCount64 = 425656284035217743u;
+
+    // Approximates the k-th prime by the inverse of the logarithmic integral, which is within about sqrt(p_k) of it.
+    inline std::uint64_t NthPrimeEstimate(const std::uint64_t k) noexcept {
+        const double n = static_cast<double>(k), lk = std::log(n);
+        double x = n * (lk + std::log(lk) - 1);
+        for (std::int32_t i = 0; i != 4; ++i) {
+            // li(x) = gamma + log(log(x)) + sum of log(x)^j / (j * j!) for j >= 1. The terms are positive, so nothing cancels.
+            const double lx = std::log(x);
+            double li = 0.5772156649015329 + std::log(lx), term = 1;
+            for (std::int32_t j = 1; j != 128; ++j) {
+                term *= lx / j;
+                li += term / j;
+            }
+            x -= (li - n) * lx;
+        }
+        return x >= 18446744073709549568.0 ? 18446744073709549568u : static_cast<std::uint64_t>(x);
+    }
+
+    // Returns the r-th prime (r >= 1) not less than lo, or 0 if there is none below 2^64. The primes are sieved in windows
+    // sized to hold about r of them, so that the sieving primes only go up to the square root of where the answer is.
+    inline std::uint64_t NthPrimeFrom(std::uint64_t lo, std::uint64_t r) {
+        const std::uint64_t small[3] = { 2, 3, 5 };
+        for (const std::uint64_t p : small)
+            if (lo <= p && --r == 0) return p;
+        PrimeSieveWorker worker;
+        while (lo != ~std::uint64_t(0)) {
+            const double width = (static_cast<double>(r) + 64) * (std::log(static_cast<double>(lo) + 2) + 1) + 65536;
+            const std::uint64_t hi = width >= static_cast<double>(~std::uint64_t(0) - lo) ? ~std::uint64_t(0) : lo + static_cast<std::uint64_t>(width);
+            worker.reset(lo, hi, PrimeRange::DefaultSegmentBytes);
+            for (std::size_t n; (n = worker.next()) != 0;) {
+                const std::uint64_t count = worker.count(n);
+                if (count < r) {
+                    r -= count;
+                    continue;
+                }
+                std::uint64_t res = 0;
+                const auto find = [&](const std::uint64_t p) {
+                    if (--r == 0) res = p;
+                };
+                ForEachSievedPrime(worker.data(), n, worker.first(), find);
+                return res;
+            }
+            lo = hi;
+        }
+        return 0;
+    }
+
+    // Returns the k-th prime given count = pi(x).
+    inline std::uint64_t NthPrimeNear(const std::uint64_t k, std::uint64_t x, std::uint64_t count) {
+        if (count < k) return NthPrimeFrom(x + 1, k - count);
+        // x is past the answer: step back in windows of about twice the distance until pi drops below k.
+        const double width = (static_cast<double>(count - k) + 64) * 2 * std::log(static_cast<double>(x) + 2) + 65536;
+        while (true) {
+            const std::uint64_t lo = static_cast<double>(x) + 1 > width ? x + 1 - static_cast<std::uint64_t>(width) : 0;
+            const std::uint64_t below = count - PrimeRange(lo, x + 1).count();
+            if (below < k) return NthPrimeFrom(lo, k - below);
+            count = below, x = lo - 1;
+        }
+    }
+
+}  // namespace internal
+
+// The number of primes below every multiple of 2^24 up to a bound, so that the k-th prime can be found by sieving one block of 2^24.
+// The file starts with a 32-byte little-endian header, followed by one uint64 per block:
+//   offset  0: the 8 bytes "CPPRPCI\n"
+//   offset  8: uint32 version (1)
+//   offset 12: uint32 header size in bytes (32)
+//   offset 16: uint32 log2 of the block size (24)
+//   offset 20: uint32 0
+//   offset 24: uint64 number of blocks n; entry i is the number of primes below (i + 1) * 2^24, and the bound is n * 2^24
+class PrimeCountIndex {
+public:
+    static constexpr std::uint32_t Version = 1;
+    static constexpr std::size_t HeaderBytes = 32;
+    static constexpr std::int32_t BlockBits = 24;
+
+private:
+    std::vector<std::uint64_t> counts_;  // counts_[i] is the number of primes below i * 2^24, from counts_[0] = 0
+
+    static std::uint64_t Load(const std::uint8_t* p, const std::int32_t bytes) noexcept {
+        std::uint64_t res = 0;
+        for (std::int32_t k = 0; k != bytes; ++k) res |= static_cast<std::uint64_t>(p[k]) << (8 * k);
+        return res;
+    }
+    static void Store(std::uint8_t* p, const std::uint64_t x, const std::int32_t bytes) noexcept {
+        for (std::int32_t k = 0; k != bytes; ++k) p[k] = static_cast<std::uint8_t>(x >> (8 * k));
+    }
+
+public:
+    PrimeCountIndex() = default;
+    explicit PrimeCountIndex(const char* path) { open(path); }
+
+    // Counts the primes in every block below bound (rounded up to a multiple of 2^24) on threads threads, and writes the index to path.
+    // Returns false if the file cannot be written.
+    static bool Create(const char* path, const std::uint64_t bound, const std::size_t threads = 0) {
+        const std::uint64_t blocks = (bound >> BlockBits) + ((bound & ((std::uint64_t(1) << BlockBits) - 1)) != 0);
+        if (blocks == 0 || blocks > 0xffffffffu) return false;
+        std::vector<std::uint64_t> counts(static_cast<std::size_t>(blocks));
+        internal::WorkStealingPool pool(threads);
+        std::vector<internal::PrimeSieveWorker> workers(pool.size());
+        auto task = [&](const std::size_t worker, const std::uint32_t i, std::uint32_t) {
+            const std::uint64_t lo = static_cast<std::uint64_t>(i) << BlockBits;
+            counts[i] = workers[worker].Count(lo, lo + (std::uint64_t(1) << BlockBits), PrimeRange::DefaultSegmentBytes);
+        };
+        pool.Run(static_cast<std::uint32_t>(blocks), task);
+        std::FILE* fp = std::fopen(path, "wb");
+        if (fp == nullptr) return false;
+        std::uint8_t header[HeaderBytes] = {};
+        std::memcpy(header, "CPPRPCI\n", 8);
+        Store(header + 8, Version, 4);
+        Store(header + 12, HeaderBytes, 4);
+        Store(header + 16, BlockBits, 4);
+        Store(header + 24, blocks, 8);
+        bool ok = std::fwrite(header, 1, HeaderBytes, fp) == HeaderBytes;
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; ok && i != counts.size(); ++i) {
+            std::uint8_t entry[8];
+            Store(entry, total += counts[i], 8);
+            ok = std::fwrite(entry, 1, 8, fp) == 8;
+        }
+        return std::fclose(fp) == 0 && ok;
+    }
+
+    // Reads the index. Returns false and leaves it empty if the file cannot be read or the counts are not increasing.
+    bool open(const char* path) {
+        close();
+        std::FILE* fp = std::fopen(path, "rb");
+        if (fp == nullptr) return false;
+        std::uint8_t header[HeaderBytes] = {};
+        bool ok = std::fread(header, 1, HeaderBytes, fp) == HeaderBytes && std::memcmp(header, "CPPRPCI\n", 8) == 0;
+        ok = ok && Load(header + 8, 4) == Version && Load(header + 12, 4) == HeaderBytes && Load(header + 16, 4) == BlockBits;
+        const std::uint64_t blocks = ok ? Load(header + 24, 8) : 0;
+        ok = ok && blocks != 0 && blocks < (std::uint64_t(1) << (64 - BlockBits));
+        if (ok) counts_.assign(static_cast<std::size_t>(blocks + 1), 0);
+        std::uint8_t entry[8];
+        for (std::size_t i = 1; ok && i != counts_.size(); ++i) ok = std::fread(entry, 1, 8, fp) == 8 && (counts_[i] = Load(entry, 8)) > counts_[i - 1];
+        std::fclose(fp);
+        if (!ok) close();
+        return ok;
+    }
+    void close() noexcept { counts_.clear(); }
+    bool is_open() const noexcept { return !counts_.empty(); }
+    // The index answers for the primes below bound(), which is 0 when no file is open.
+    std::uint64_t bound() const noexcept { return counts_.empty() ? 0 : (counts_.size() - 1) << BlockBits; }
+    // The number of primes below bound().
+    std::uint64_t count() const noexcept { return counts_.empty() ? 0 : counts_.back(); }
+
+    // Returns the k-th prime (k >= 1) from the index and one block of sieving, or 0 if it is not below bound().
+    std::uint64_t nth_prime(const std::uint64_t k) const {
+        if (k == 0 || k > count()) return 0;
+        // counts_[i - 1] < k <= counts_[i]
+        std::size_t lo = 0, hi = counts_.size() - 1;
+        while (hi - lo > 1) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (counts_[mid] < k) lo = mid;
+            else hi = mid;
+        }
+        const std::uint64_t res = internal::NthPrimeFrom(static_cast<std::uint64_t>(lo) << BlockBits, k - counts_[lo]);
+        // A damaged index shows up as an answer outside the block.
+        return res >> BlockBits == lo && IsPrime(res) ? res : 0;
+    }
+};
+
+// Returns the k-th prime (the 1st is 2), or 0 if k == 0 or the k-th prime is above 2^64.
+// The answer is estimated by the inverse of the logarithmic integral, corrected with PrimePi on threads threads
+// (one per hardware thread if threads == 0), and found by sieving from there.
+inline std::uint64_t NthPrime(const std::uint64_t k, const std::size_t threads = 0) {
+    if (k == 0 || k > internal::PrimeCount64) return 0;
+    // Up to 2^24 a sieve from 0 is quicker than pi(x).
+    if (k <= 1077871) return internal::NthPrimeFrom(0, k);
+    const std::uint64_t x = internal::NthPrimeEstimate(k);
+    return internal::NthPrimeNear(k, x, PrimePi(x, threads));
+}
+
+// Returns the k-th prime from the index if it covers it, and from NthPrime(k, threads) otherwise.
+inline std::uint64_t NthPrime(const std::uint64_t k, const PrimeCountIndex& index, const std::size_t threads = 0) {
+    const std::uint64_t res = index.nth_prime(k);
+    return res != 0 ? res : NthPrime(k, threads);
+}
+
+}  // namespace cppr
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * libcpprime ParallelSieve.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#include "./PrimeSieve.hpp"
+#include "./internal/ThreadPool.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_PARALLEL_SIEVE
+#define LIBCPPRIME_INCLUDED_PARALLEL_SIEVE
+
+namespace cppr {
+
+namespace internal {
+
+    // Splits the bytes of the sieve of [lo, hi) into chunks of whole segments for a WorkStealingPool.
+    // A worker keeps sieving from one chunk into the next while it is handed consecutive chunks,
+    // so the sieving primes are set up once per share of the pool rather than once per chunk.
+    class ParallelSieve {
+        struct Worker {
+            PrimeSieveWorker sieve;
+            std::uint64_t next_chunk = 0, end_chunk = 0;  // chunks [next_chunk, end_chunk) are still ahead in the sieve
+            std::uint64_t count = 0;
+        };
+        std::uint64_t lo_, hi_, begin_, end_, chunk_bytes_;
+        std::size_t segment_bytes_;
+        std::uint32_t chunks_;
+        std::vector<Worker> workers_;
+    public:
+        static constexpr std::size_t ChunkSegments = 32;
+        ParallelSieve(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes, const std::size_t threads)
+            : lo_(lo), hi_(hi), begin_(lo / 30), end_(lo < hi ? (hi - 1) / 30 + 1 : lo / 30), segment_bytes_(SegmentedSieve::RoundSegmentBytes(segment_bytes)), workers_(threads) {
+            chunk_bytes_ = ChunkSegments * segment_bytes_;
+            // Keep the number of chunks within the 32-bit indices of the pool.
+            while ((end_ - begin_) / chunk_bytes_ >= (1u << 30)) chunk_bytes_ *= 2;
+            chunks_ = static_cast<std::uint32_t>((end_ - begin_ + chunk_bytes_ - 1) / chunk_bytes_);
+        }
+        std::uint32_t chunks() const noexcept { return chunks_; }
+        std::uint64_t chunk_bytes() const noexcept { return chunk_bytes_; }
+        std::uint64_t first(const std::uint64_t chunk) const noexcept { return begin_ + chunk * chunk_bytes_; }
+        std::size_t bytes(const std::uint64_t chunk) const noexcept { return static_cast<std::size_t>(end_ - first(chunk) < chunk_bytes_ ? end_ - first(chunk) : chunk_bytes_); }
+        std::uint64_t lo(const std::uint64_t chunk) const noexcept { return chunk == 0 ? lo_ : 30 * first(chunk); }
+        std::uint64_t hi(const std::uint64_t chunk) const noexcept { return chunk + 1 == chunks_ ? hi_ : 30 * first(chunk + 1); }
+        std::uint64_t count(const std::size_t worker) const noexcept { return workers_[worker].count; }
+        // Sieves chunk on worker and calls f(sieve, offset, n) for each of its segments, where sieve.data() holds exactly the primes
+        // among the numbers coprime to 30 in bytes [offset, offset + n) of the chunk and is padded to a multiple of 8 bytes.
+        // end is the end of the share of worker, which bounds how far its sieve may run ahead.
+        template<class F> void Sieve(const std::size_t worker, const std::uint64_t chunk, const std::uint64_t end, F& f) {
+            Worker& w = workers_[worker];
+            if (chunk != w.next_chunk || chunk >= w.end_chunk) {
+                w.sieve.reset(lo(chunk), hi(end - 1), segment_bytes_);
+                w.end_chunk = end;
+            }
+            w.next_chunk = chunk + 1;
+            const std::size_t total = bytes(chunk);
+            for (std::size_t offset = 0, n; offset < total && (n = w.sieve.next()) != 0; offset += n) f(w.sieve, offset, n);
+        }
+        void SieveAndCount(const std::size_t worker, const std::uint64_t chunk, const std::uint64_t end) {
+            Worker& w = workers_[worker];
+            const auto add = [&w](const PrimeSieveWorker& sieve, std::size_t, const std::size_t n) { w.count += sieve.count(n); };
+            Sieve(worker, chunk, end, add);
+        }
+    };
+
+    // Chunks of the same wave are sieved in parallel, and each worker's share of a wave should be wide enough
+    // that setting up the sieving primes up to sqrt(hi) does not dominate.
+    inline std::uint32_t WaveChunks(const ParallelSieve& sieve, const std::uint64_t hi, const std::size_t threads) noexcept {
+        const std::uint64_t per_worker = 2 * Isqrt(hi - 1) / 30 / sieve.chunk_bytes() + 1;
+        const std::uint64_t wave = threads * (per_worker < 8 ? 8 : per_worker);
+        return static_cast<std::uint32_t>(wave < sieve.chunks() ? wave : sieve.chunks());
+    }
+
+}  // namespace internal
+
+// Returns the number of primes in [lo, hi), using threads threads (one per hardware thread if threads == 0).
+inline std::uint64_t CountPrimes(const std::uint64_t lo, const std::uint64_t hi, const std::size_t threads = 0, const std::size_t segment_bytes = PrimeRange::DefaultSegmentBytes) {
+    if (lo >= hi) return 0;
+    const std::size_t n = internal::ThreadCount(threads);
+    internal::ParallelSieve sieve(lo, hi, segment_bytes, n);
+    if (n == 1 || sieve.chunks() < 2) return PrimeRange(lo, hi, segment_bytes).count();
+    internal::WorkStealingPool pool(n);
+    std::uint64_t res = 0;
+    const std::uint64_t small[3] = { 2, 3, 5 };
+    for (const std::uint64_t p : small) res += lo <= p && p < hi;
+    auto task = [&](const std::size_t worker, const std::uint32_t chunk, const std::uint32_t end) { sieve.SieveAndCount(worker, chunk, end); };
+    pool.Run(sieve.chunks(), task);
+    for (std::size_t i = 0; i != pool.size(); ++i) res += sieve.count(i);
+    return res;
+}
+
+// Calls f with every prime in [lo, hi) in increasing order, sieving on threads threads (one per hardware thread if threads == 0).
+// f itself is always called from the calling thread, while the next chunks of the range are being sieved.
+template<class F> void ForEachPrimeParallel(const std::uint64_t lo, const std::uint64_t hi, F&& f, const std::size_t threads = 0, const std::size_t segment_bytes = PrimeRange::DefaultSegmentBytes) {
+    if (lo >= hi) return;
+    const std::size_t n = internal::ThreadCount(threads);
+    internal::ParallelSieve sieve(lo, hi, segment_bytes, n);
+    if (n == 1 || sieve.chunks() < 2) {
+        PrimeRange(lo, hi, segment_bytes).for_each(f);
+        return;
+    }
+    internal::WorkStealingPool pool(n);
+    const std::uint64_t small[3] = { 2, 3, 5 };
+    for (const std::uint64_t p : small)
+        if (lo <= p && p < hi) f(p);
+    // Two waves of chunk bitmaps: one is filled by the pool while the calling thread reports the primes of the other.
+    const std::uint32_t wave = internal::WaveChunks(sieve, hi, pool.size());
+    std::vector<std::vector<std::uint8_t>> bitmaps(2 * static_cast<std::size_t>(wave));
+    std::uint32_t base = 0;
+    auto task = [&](const std::size_t worker, const std::uint32_t index, const std::uint32_t end) {
+        const std::uint32_t chunk = base + index;
+        std::vector<std::uint8_t>& bitmap = bitmaps[chunk % bitmaps.size()];
+        bitmap.resize(static_cast<std::size_t>(sieve.chunk_bytes()));
+        const auto copy = [&bitmap](const internal::PrimeSieveWorker& s, const std::size_t offset, const std::size_t n) { std::memcpy(bitmap.data() + offset, s.data(), (n + 7) / 8 * 8); };
+        sieve.Sieve(worker, chunk, base + end, copy);
+    };
+    const auto report = [&](const std::uint32_t from, const std::uint32_t to) {
+        for (std::uint32_t chunk = from; chunk != to; ++chunk) internal::ForEachSievedPrime(bitmaps[chunk % bitmaps.size()].data(), sieve.bytes(chunk), sieve.first(chunk), f);
+    };
+    pool.Run(wave, task);
+    while (true) {
+        const std::uint32_t done = base + wave < sieve.chunks() ? base + wave : sieve.chunks();
+        if (done == sieve.chunks()) {
+            report(base, done);
+            break;
+        }
+        const std::uint32_t previous = base;
+        base = done;
+        pool.Start(sieve.chunks() - base < wave ? sieve.chunks() - base : wave, task);
+        report(previous, base);
+        pool.Wait();
+    }
+}
+
+}  // namespace cppr
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * libcpprime PrimalityCache.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#include "./IsPrime.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_PRIMALITY_CACHE
+#define LIBCPPRIME_INCLUDED_PRIMALITY_CACHE
+
+#include <atomic>
+#include <memory>
+#include <new>
+
+namespace cppr {
+
+// A fixed-size table of recent results of cppr::IsPrime for odd inputs of 2^32 or more that have no prime factor up to 17, which can be shared by any number of threads.
+// Each slot is one atomic word that holds the input itself with its lowest bit replaced by the result, so a slot can only answer for the exact input that was stored in it,
+// and a race between two writers can lose an entry but never mix two of them. Smaller inputs and the other composites are cheaper to test than to look up, so they bypass the table.
+class PrimalityCache {
+public:
+    // A set is one cache line of slots. A new entry goes to the front of its set and pushes the oldest one out.
+    static constexpr std::size_t Ways = 8;
+
+    struct Stats {
+        std::uint64_t hits, misses;
+    };
+
+private:
+    // The hit and miss counters are split into stripes on separate cache lines, and each thread counts on its own stripe, so that threads that hit the same entry do not write to one line.
+    static constexpr std::size_t Stripes = 16;
+    struct Stripe {
+        std::atomic<std::uint64_t> hits, misses;
+        char padding[64 - 2 * sizeof(std::atomic<std::uint64_t>)];
+    };
+    std::unique_ptr<std::atomic<std::uint64_t>[]> buffer_;
+    std::atomic<std::uint64_t>* slots_ = nullptr;  // the sets, aligned to 64 bytes inside buffer_
+    std::int32_t shift_ = 63;                       // the set of n is (n * multiplier) >> shift_
+    std::size_t sets_ = 0;
+    std::unique_ptr<Stripe[]> stripes_;
+
+    static std::size_t StripeIndex() noexcept {
+        static std::atomic<std::size_t> next(0);
+        static thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % Stripes;
+        return index;
+    }
+    std::atomic<std::uint64_t>* Find(const std::uint64_t n) const noexcept {
+        return slots_ + ((n * 0x9e3779b97f4a7c15u) >> shift_) * Ways;
+    }
+
+public:
+    // Allocates the smallest power of two number of sets that holds at least capacity entries. If the allocation fails, the cache holds nothing and every call is a miss.
+    explicit PrimalityCache(const std::size_t capacity = 1 << 16) noexcept {
+        std::size_t sets = 2;
+        std::int32_t bits = 1;
+        while (sets * Ways < capacity && bits != 40) sets <<= 1, ++bits;
+        buffer_.reset(new (std::nothrow) std::atomic<std::uint64_t>[sets * Ways + Ways - 1]);
+        stripes_.reset(new (std::nothrow) Stripe[Stripes]);
+        if (!buffer_ || !stripes_) {
+            buffer_.reset(), stripes_.reset();
+            return;
+        }
+        const std::size_t offset = (64 - reinterpret_cast<std::uintptr_t>(buffer_.get()) % 64) % 64 / sizeof(std::uint64_t);
+        slots_ = buffer_.get() + offset, shift_ = 64 - bits, sets_ = sets;
+        clear();
+    }
+    PrimalityCache(const PrimalityCache&) = delete;
+    PrimalityCache& operator=(const PrimalityCache&) = delete;
+
+    // The number of entries the cache can hold, or 0 if the allocation failed.
+    std::size_t capacity() const noexcept { return sets_ * Ways; }
+
+    bool is_prime(const std::uint64_t n) noexcept {
+        if (n <= 0xffffffff || internal::HasSmallFactor(n) || sets_ == 0) return IsPrime(n);
+        std::atomic<std::uint64_t>* set = Find(n);
+        Stripe& stripe = stripes_[StripeIndex()];
+        for (std::size_t i = 0; i != Ways; ++i) {
+            const std::uint64_t slot = set[i].load(std::memory_order_relaxed);
+            if ((slot ^ n) <= 1) {
+                stripe.hits.fetch_add(1, std::memory_order_relaxed);
+                return slot & 1;
+            }
+        }
+        stripe.misses.fetch_add(1, std::memory_order_relaxed);
+        const bool res = IsPrime(n);
+        for (std::size_t i = Ways - 1; i != 0; --i) set[i].store(set[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        set[0].store((n ^ 1) | res, std::memory_order_relaxed);
+        return res;
+    }
+
+    // Empties the table and resets the counters. Calls from other threads at the same time stay correct, but may leave some entries in the table.
+    void clear() noexcept {
+        for (std::size_t i = 0; i != sets_ * Ways; ++i) slots_[i].store(0, std::memory_order_relaxed);
+        for (std::size_t i = 0; stripes_ && i != Stripes; ++i) stripes_[i].hits.store(0, std::memory_order_relaxed), stripes_[i].misses.store(0, std::memory_order_relaxed);
+    }
+
+    // The numbers of inputs found in the table and not found, over all threads. Inputs that bypass the table are not counted.
+    Stats stats() const noexcept {
+        Stats res = { 0, 0 };
+        for (std::size_t i = 0; stripes_ && i != Stripes; ++i) res.hits += stripes_[i].hits.load(std::memory_order_relaxed), res.misses += stripes_[i].misses.load(std::memory_order_relaxed);
+        return res;
+    }
+};
+
+}  // namespace cppr
+
+#endif
@@ -0,0 +1,181 @@
+/**
+ * libcpprime PrimeBitmap.hpp https://github.com/Rac75116/libcpprime
+ * 
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+**/
+
+
+#include "./PrimeSieve.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_PRIME_BITMAP
+#define LIBCPPRIME_INCLUDED_PRIME_BITMAP
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#if !defined(LIBCPPRIME_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LIBCPPRIME_PRIME_BITMAP_MMAP
+#endif
+
+namespace cppr {
+
+// A read-only table of the primes below a bound, stored as the sieve of PrimeSieve.hpp: each byte covers 30 integers.
+// The file starts with a 32-byte little-endian header:
+//   offset  0: the 8 bytes "CPPRBMP\n"
+//   offset  8: uint32 version (1)
+//   offset 12: uint32 header size in bytes (32)
+//   offset 16: uint64 bound
+//   offset 24: uint64 number of data bytes, (bound + 29) / 30
+class PrimeBitmap {
+public:
+    static constexpr std::uint32_t Version = 1;
+    static constexpr std::size_t HeaderBytes = 32;
+
+private:
+    const std::uint8_t* data_ = nullptr;
+    std::uint64_t bound_ = 0;
+    void* map_ = nullptr;
+    std::size_t map_bytes_ = 0;
+    std::unique_ptr<std::uint8_t[]> buffer_;
+
+    static std::uint64_t Load(const std::uint8_t* p, const std::int32_t bytes) noexcept {
+        std::uint64_t res = 0;
+        for (std::int32_t k = 0; k != bytes; ++k) res |= static_cast<std::uint64_t>(p[k]) << (8 * k);
+        return res;
+    }
+    static void Store(std::uint8_t* p, const std::uint64_t x, const std::int32_t bytes) noexcept {
+        for (std::int32_t k = 0; k != bytes; ++k) p[k] = static_cast<std::uint8_t>(x >> (8 * k));
+    }
+    // Returns the bound stored in the header, or 0 if the header is not valid for a file of file_bytes bytes.
+    static std::uint64_t ParseHeader(const std::uint8_t* header, const std::uint64_t file_bytes) noexcept {
+        if (std::memcmp(header, "CPPRBMP\n", 8) != 0 || Load(header + 8, 4) != Version || Load(header + 12, 4) != HeaderBytes) return 0;
+        const std::uint64_t bound = Load(header + 16, 8), bytes = Load(header + 24, 8);
+        if (bound == 0 || bytes != bound / 30 + (bound % 30 != 0) || file_bytes - HeaderBytes < bytes) return 0;
+        return bound;
+    }
+
+public:
+    PrimeBitmap() = default;
+    explicit PrimeBitmap(const char* path) noexcept { open(path); }
+    PrimeBitmap(const PrimeBitmap&) = delete;
+    PrimeBitmap& operator=(const PrimeBitmap&) = delete;
+    PrimeBitmap(PrimeBitmap&& other) noexcept { *this = static_cast<PrimeBitmap&&>(other); }
+    PrimeBitmap& operator=(PrimeBitmap&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = other.data_, bound_ = other.bound_, map_ = other.map_, map_bytes_ = other.map_bytes_;
+            buffer_ = static_cast<std::unique_ptr<std::uint8_t[]>&&>(other.buffer_);
+            other.data_ = nullptr, other.bound_ = 0, other.map_ = nullptr, other.map_bytes_ = 0;
+        }
+        return *this;
+    }
+    ~PrimeBitmap() { close(); }
+
+    // Writes the table of the primes below bound to path. Returns false without touching path if bound is 0, and false if the file cannot be written.
+    static bool Create(const char* path, const std::uint64_t bound, const std::size_t segment_bytes = std::size_t(1) << 20) {
+        if (bound == 0) return false;
+        std::FILE* fp = std::fopen(path, "wb");
+        if (fp == nullptr) return false;
+        std::uint8_t header[HeaderBytes] = {};
+        std::memcpy(header, "CPPRBMP\n", 8);
+        Store(header + 8, Version, 4);
+        Store(header + 12, HeaderBytes, 4);
+        Store(header + 16, bound, 8);
+        Store(header + 24, bound / 30 + (bound % 30 != 0), 8);
+        bool ok = std::fwrite(header, 1, HeaderBytes, fp) == HeaderBytes;
+        internal::SegmentedSieve sieve(0, bound, segment_bytes);
+        for (std::size_t n = 0; ok && (n = sieve.next()) != 0;) ok = std::fwrite(sieve.data(), 1, n, fp) == n;
+        return std::fclose(fp) == 0 && ok;
+    }
+
+    // Maps the file into memory, or reads it where mmap is not available. Returns false and leaves the table empty on failure.
+    bool open(const char* path) noexcept {
+        close();
+#ifdef LIBCPPRIME_PRIME_BITMAP_MMAP
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<std::uint64_t>(st.st_size) < HeaderBytes) {
+            ::close(fd);
+            return false;
+        }
+        void* map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) return false;
+        const std::uint64_t bound = ParseHeader(static_cast<const std::uint8_t*>(map), static_cast<std::uint64_t>(st.st_size));
+        if (bound == 0) {
+            ::munmap(map, static_cast<std::size_t>(st.st_size));
+            return false;
+        }
+#ifdef MADV_RANDOM
+        ::madvise(map, static_cast<std::size_t>(st.st_size), MADV_RANDOM);
+#endif
+        map_ = map, map_bytes_ = static_cast<std::size_t>(st.st_size);
+        data_ = static_cast<const std::uint8_t*>(map) + HeaderBytes, bound_ = bound;
+        return true;
+#else
+        std::FILE* fp = std::fopen(path, "rb");
+        if (fp == nullptr) return false;
+        std::uint8_t header[HeaderBytes] = {};
+        bool ok = std::fread(header, 1, HeaderBytes, fp) == HeaderBytes;
+        const std::uint64_t bound = ok ? ParseHeader(header, ~std::uint64_t(0)) : 0;
+        if (bound != 0) {
+            const std::size_t bytes = static_cast<std::size_t>(Load(header + 24, 8));
+            buffer_.reset(new (std::nothrow) std::uint8_t[bytes]);
+            ok = buffer_ && std::fread(buffer_.get(), 1, bytes, fp) == bytes;
+        }
+        std::fclose(fp);
+        if (bound == 0 || !ok) {
+            buffer_.reset();
+            return false;
+        }
+        data_ = buffer_.get(), bound_ = bound;
+        return true;
+#endif
+    }
+    void close() noexcept {
+#ifdef LIBCPPRIME_PRIME_BITMAP_MMAP
+        if (map_ != nullptr) ::munmap(map_, map_bytes_);
+#endif
+        buffer_.reset();
+        data_ = nullptr, bound_ = 0, map_ = nullptr, map_bytes_ = 0;
+    }
+    bool is_open() const noexcept { return data_ != nullptr; }
+    // The table answers for the integers below bound(), which is 0 when no file is open.
+    std::uint64_t bound() const noexcept { return bound_; }
+
+    bool is_prime(const std::uint64_t n) const noexcept {
+        if (n >= bound_) return cppr::IsPrime(n);
+        if (n < 6) return (0x2c >> n) & 1;
+        return (data_[n / 30] >> internal::WheelIndex[n % 30]) & 1;
+    }
+};
+
+}  // namespace cppr
+
+#endif
@@ -0,0 +1,463 @@
+/**
+ * libcpprime PrimePi.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+
+#include "./PrimeSieve.hpp"
+#include "./internal/ThreadPool.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_PRIME_PI
+#define LIBCPPRIME_INCLUDED_PRIME_PI
+
+#include <cstring>
+#include <vector>
+
+namespace cppr {
+
+namespace internal {
+
+    inline std::uint64_t Icbrt(const std::uint64_t x) noexcept {
+        std::uint64_t lo = 0, hi = 2642246;  // 2642246^3 > 2^64 > 2642245^3
+        while (hi - lo > 1) {
+            const std::uint64_t mid = (lo + hi) / 2;
+            if (mid * mid * mid <= x) lo = mid;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // The counting functions below are written once for the weights w(n) = 1 and w(n) = n, which are completely multiplicative.
+    // They compute modulo 2^64 or 2^128: partial sums may wrap around, but the final results fit.
+    struct CountWeight {
+        using type = std::uint64_t;
+        static constexpr bool Sum = false;
+        static type Of(std::uint64_t) noexcept { return 1; }
+        // The total weight of the set bits of a sieve word whose first byte has index byte.
+        static type Word(const std::uint64_t w, std::uint64_t) noexcept { return static_cast<type>(Popcount(w)); }
+    };
+#if defined(__SIZEOF_INT128__)
+    struct SumWeight {
+        using type = unsigned __int128;
+        static constexpr bool Sum = true;
+        static type Of(const std::uint64_t n) noexcept { return n; }
+        static type Word(const std::uint64_t w, const std::uint64_t byte) noexcept {
+            // Bit k of byte j stands for 30 * (byte + j) + WheelResidues[k]. The sums over j and over the binary digits of the residues
+            // are taken with one mask per digit: 0x66 selects the residues with 2 set (7, 11, 19, 23), 0xca those with 4, and so on.
+            const std::uint64_t count = static_cast<std::uint64_t>(Popcount(w));
+            const std::uint64_t bytes = static_cast<std::uint64_t>(Popcount(w & 0xff00ff00ff00ff00u) + 2 * Popcount(w & 0xffff0000ffff0000u) + 4 * Popcount(w & 0xffffffff00000000u));
+            const std::uint64_t residues = count + static_cast<std::uint64_t>(2 * Popcount(w & 0x6666666666666666u) + 4 * Popcount(w & 0xcacacacacacacacau) + 8 * Popcount(w & 0x8c8c8c8c8c8c8c8cu) + 16 * Popcount(w & 0xf0f0f0f0f0f0f0f0u));
+            return 30 * (static_cast<type>(byte) * count + bytes) + residues;
+        }
+    };
+#endif
+
+    // The primes up to y with the prefix sums of their weights, pi(v) for v <= y, and mu(m) * lpf(m) for the odd m <= y.
+    template<class Weight> class PrimePiTables {
+        using T = typename Weight::type;
+        std::vector<std::uint8_t> bitmap_;   // the primes up to y, as the sieve of PrimeSieve.hpp
+        std::vector<std::uint32_t> counts_;  // counts_[i] is the number of primes above 5 below byte 8 * i
+    public:
+        static constexpr std::int32_t Infinity = 0x7fffffff;  // lpf(1)
+        std::uint64_t y;
+        std::vector<std::uint32_t> primes;  // primes[k] is the k-th prime, from primes[1] = 2
+        std::vector<T> prefix;              // prefix[k] = w(primes[1]) + ... + w(primes[k])
+        std::vector<std::int32_t> factor;   // factor[m / 2] = mu(m) * lpf(m) for odd m, or 0 if m is not squarefree
+        explicit PrimePiTables(const std::uint64_t bound) : y(bound) {
+            SegmentedSieve sieve(0, y + 1, std::size_t(1) << 16);
+            for (std::size_t n; (n = sieve.next()) != 0;) bitmap_.insert(bitmap_.end(), sieve.data(), sieve.data() + n);
+            bitmap_.resize(bitmap_.size() / 8 * 8 + 8);
+            counts_.resize(bitmap_.size() / 8 + 1);
+            for (std::size_t i = 0; i != bitmap_.size() / 8; ++i) counts_[i + 1] = counts_[i] + static_cast<std::uint32_t>(Popcount(LoadSieveWord(bitmap_.data() + 8 * i)));
+            primes = { 0, 2, 3, 5 };
+            primes.reserve(counts_.back() + 4);
+            const auto push = [this](const std::uint64_t p) { primes.push_back(static_cast<std::uint32_t>(p)); };
+            ForEachSievedPrime(bitmap_.data(), bitmap_.size(), 0, push);
+            prefix.resize(primes.size());
+            for (std::size_t k = 1; k != primes.size(); ++k) prefix[k] = prefix[k - 1] + Weight::Of(primes[k]);
+            factor.assign(static_cast<std::size_t>((y + 1) / 2), std::int32_t(Infinity));
+            for (std::size_t k = 2; k != primes.size(); ++k) {
+                const std::uint64_t p = primes[k];
+                for (std::uint64_t m = p; m <= y; m += 2 * p) {
+                    std::int32_t& f = factor[m / 2];
+                    if (f == Infinity || f == -Infinity) f = f > 0 ? static_cast<std::int32_t>(p) : -static_cast<std::int32_t>(p);
+                    f = -f;
+                }
+                for (std::uint64_t m = p * p; m <= y; m += 2 * p * p) factor[m / 2] = 0;
+            }
+        }
+        std::uint64_t a() const noexcept { return primes.size() - 1; }
+        // pi(v) for v <= y.
+        std::uint64_t pi(const std::uint64_t v) const noexcept {
+            if (v < 7) return v < 2 ? 0 : v < 3 ? 1 : v < 5 ? 2 : 3;
+            constexpr std::uint8_t residues_upto[30] = { 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 4, 4, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 8 };
+            const std::uint64_t byte = v / 30, word = byte / 8, shift = 8 * (byte % 8);
+            const std::uint64_t mask = ((std::uint64_t(1) << shift) - 1) | ((std::uint64_t(1) << residues_upto[v % 30]) - 1) << shift;
+            return 3 + counts_[word] + static_cast<std::uint64_t>(Popcount(LoadSieveWord(bitmap_.data() + 8 * word) & mask));
+        }
+    };
+
+
+    // The Lagarias-Miller-Odlyzko method with the leaf classification of Deleglise and Rivat. For y >= cbrt(x) and a = pi(y),
+    //   sum of w(p) over p <= x = phi(x, a) + (sum of w(p) over p <= y) - 1 - P2,
+    // where phi(x, b) is the weight of the n <= x free of the first b primes and P2 that of the n = p * q <= x with y < p <= q.
+    // phi(x, a) is expanded into leaves mu(n) * w(n) * phi(x / n, b). The ordinary leaves (n <= y, b = C) come from a table of
+    // phi(., C); the special leaves (n = p_b * m > y with m <= y and b > C) are either read from the primes up to y, when
+    // x / n < min(p_b^2, y + 1), or counted on a segmented sieve of [0, x / y] that is only carried through the primes up to
+    // max(sqrt(x / y), x^(1/4)). That sieve and P2 are split into chunks that run on a WorkStealingPool.
+    template<class Weight> class PrimePiLMO {
+        using T = typename Weight::type;
+        using Tables = PrimePiTables<Weight>;
+        static constexpr std::int32_t C = 6, PrimeC = 13;  // phi(., C) is periodic modulo 2 * 3 * 5 * 7 * 11 * 13
+        static constexpr std::uint32_t Primorial = 30030, Totient = 5760;
+        static constexpr std::size_t SegmentBytes = std::size_t(1) << 16, BlockBytes = 512, ChunkSegments = 16;
+        struct SievingPrime {
+            std::uint32_t a, i, j;  // p = 30 * a + WheelResidues[i], and the next multiple is p * q with q % 30 == WheelResidues[j]
+            std::uint64_t next;     // byte offset of the next multiple from the current segment
+        };
+        // What a chunk of the sieve contributes, relative to the weights phi(30 * first - 1, b - 1) that it cannot know.
+        struct ChunkResult {
+            std::vector<T> coefficient;  // the sum of -mu(m) * w(p_b * m) over the leaves of b in the chunk
+            std::vector<T> survivors;    // the weight of the chunk after sieving by the first b - 1 primes
+            T local = 0;                 // the leaves with phi counted from the start of the chunk
+        };
+        struct Worker {
+            std::vector<std::uint8_t> buffer = std::vector<std::uint8_t>(SegmentBytes + 8);
+            std::vector<T> blocks = std::vector<T>(SegmentBytes / BlockBytes);
+            std::vector<SievingPrime> primes;
+            std::uint64_t next_chunk = ~std::uint64_t(0);
+            T sum = 0;
+        };
+        std::uint64_t x_, y_, z_, limit_;
+        const Tables tables_;
+        std::vector<std::uint16_t> phi_count_;  // phi(r, C) for r < Primorial, and its weight
+        std::vector<T> phi_weight_;
+        WorkStealingPool pool_;
+        std::vector<Worker> workers_;
+        static std::uint64_t ChooseY(const std::uint64_t x) noexcept {
+            // y = alpha * cbrt(x) trades the sieve of [0, x / y] against the easy leaves, which grow like y^2 / log(y)^2.
+            // alpha = 2 * log10(x) - 20 was the best choice from 10^13 to 10^16.
+            const std::uint64_t c = Icbrt(x);
+            std::uint64_t alpha = 2;
+            for (std::uint64_t t = x / 1000000000000u; t != 0; t /= 10) alpha += 2;
+            const std::uint64_t y = c * alpha, s = Isqrt(x);
+            return y < s ? y : s;
+        }
+        // phi(n, C) with its weight, from the table of one period of the primorial.
+        T PhiC(const std::uint64_t n) const noexcept {
+            const std::uint64_t q = n / Primorial, r = n % Primorial;
+            if (!Weight::Sum) return static_cast<T>(q) * Totient + phi_count_[r];
+            const T triangle = q % 2 == 0 ? static_cast<T>(q / 2) * (q - (q != 0)) : static_cast<T>(q) * ((q - 1) / 2);
+            return static_cast<T>(q) * (static_cast<T>(Primorial) * Totient / 2) + static_cast<T>(Primorial) * Totient * triangle + static_cast<T>(q) * Primorial * phi_count_[r] + phi_weight_[r];
+        }
+        T OrdinaryLeaves() const noexcept {
+            T res = 0;
+            for (std::uint64_t m = 1; m <= y_; m += 2) {
+                const std::int32_t f = tables_.factor[m / 2];
+                if (f > PrimeC || f < -PrimeC) {
+                    const T leaf = Weight::Of(m) * PhiC(x_ / m);
+                    res += f > 0 ? leaf : 0 - leaf;
+                }
+            }
+            return res;
+        }
+        // The special leaves of b whose phi comes from the tables.
+        T EasyLeaves(const std::uint64_t b) const noexcept {
+            const Tables& t = tables_;
+            const std::uint64_t p = t.primes[b], xp = x_ / p, m0 = p > y_ / p ? p : y_ / p;
+            const std::uint64_t bound = p * p < y_ + 1 ? p * p : y_ + 1, m_easy = xp / bound + 1;
+            T res = 0;
+            if (p * p <= y_) {
+                // m may be composite. phi(v, b - 1) is 1 plus the weight of the primes in [p, v].
+                for (std::uint64_t m = ((m0 + 1 > m_easy ? m0 + 1 : m_easy) | 1); m <= y_; m += 2) {
+                    const std::int32_t f = t.factor[m / 2];
+                    if (f == 0 || (f > 0 ? f : -f) <= static_cast<std::int64_t>(p)) continue;
+                    const std::uint64_t k = t.pi(xp / m);
+                    const T leaf = Weight::Of(p) * Weight::Of(m) * (1 + (k >= b ? t.prefix[k] - t.prefix[b - 1] : 0));
+                    res += f > 0 ? 0 - leaf : leaf;
+                }
+                return res;
+            }
+            // m is a prime p_j > p, and mu(m) = -1. The leaves with x / (p * m) < p have phi = 1.
+            const std::uint64_t m_lo = m0 > m_easy - 1 ? m0 : m_easy - 1;
+            if (m_lo >= y_) return 0;
+            const std::uint64_t lo = t.pi(m_lo) + 1, a = t.a();
+            const std::uint64_t trivial = xp / p < y_ ? t.pi(xp / p) + 1 : a + 1;
+            const std::uint64_t first_trivial = trivial > lo ? trivial : lo;
+            if (first_trivial <= a) res += Weight::Of(p) * (Weight::Sum ? t.prefix[a] - t.prefix[first_trivial - 1] : a + 1 - first_trivial);
+            // The other leaves come in clusters of consecutive m with the same pi(x / (p * m)). Below about 2 * sqrt(x / p) the clusters
+            // hold few leaves, and finding their ends costs more than taking the leaves one by one.
+            const std::uint64_t root = 2 * Isqrt(xp);
+            T sparse = 0;
+            std::uint64_t j = lo;
+            for (; j < first_trivial && t.primes[j] <= root; ++j) {
+                const std::uint64_t k = t.pi(xp / t.primes[j]);
+                sparse += Weight::Sum ? Weight::Of(t.primes[j]) * t.prefix[k] : k;
+            }
+            res += Weight::Of(p) * (sparse + (1 - t.prefix[b - 1]) * (Weight::Sum ? t.prefix[j - 1] - t.prefix[lo - 1] : j - lo));
+            while (j < first_trivial) {
+                const std::uint64_t k = t.pi(xp / t.primes[j]), last = xp / t.primes[k];
+                std::uint64_t end = t.pi(last < y_ ? last : y_);
+                if (end >= first_trivial) end = first_trivial - 1;
+                res += Weight::Of(p) * (Weight::Sum ? t.prefix[end] - t.prefix[j - 1] : end + 1 - j) * (1 + t.prefix[k] - t.prefix[b - 1]);
+                j = end + 1;
+            }
+            return res;
+        }
+        // The weight of the survivors in bytes [0, pos] of the segment that are at most v, continuing from the last query.
+        struct Query {
+            std::uint64_t block = 0, word = 0;
+            T block_sum = 0, word_sum = 0;
+        };
+        static T Count(const Worker& w, Query& q, const std::uint64_t first, const std::uint64_t v) noexcept {
+            constexpr std::uint8_t residues_upto[30] = { 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 4, 4, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 8 };
+            const std::uint64_t pos = v / 30 - first, word = pos / 8, block = pos / BlockBytes;
+            if (block != q.block) {
+                for (; q.block != block; ++q.block) q.block_sum += w.blocks[q.block];
+                q.word = block * (BlockBytes / 8), q.word_sum = q.block_sum;
+            }
+            for (; q.word != word; ++q.word) q.word_sum += Weight::Word(LoadSieveWord(w.buffer.data() + 8 * q.word), first + 8 * q.word);
+            const std::uint64_t shift = 8 * (pos % 8);
+            const std::uint64_t mask = ((std::uint64_t(1) << shift) - 1) | ((std::uint64_t(1) << residues_upto[v % 30]) - 1) << shift;
+            return q.word_sum + Weight::Word(LoadSieveWord(w.buffer.data() + 8 * word) & mask, first + 8 * word);
+        }
+        // Removes the multiples of sp in the n bytes of the segment, keeping the block sums and the total in step.
+        static void Cross(Worker& w, SievingPrime& sp, const std::uint64_t first, const std::size_t n) noexcept {
+            std::uint8_t* const buf = w.buffer.data();
+            std::uint64_t b = sp.next;
+            std::uint32_t j = sp.j;
+            for (; b < n; b += sp.a * WheelDelta[j] + WheelCarry[sp.i][j], j = (j + 1) & 7) {
+                const std::uint32_t k = WheelBit[sp.i][j], hit = buf[b] >> k & 1;
+                buf[b] &= static_cast<std::uint8_t>(~(1u << k));
+                const T removed = hit * Weight::Of(30 * (first + b) + WheelResidues[k]);
+                w.blocks[b / BlockBytes] -= removed, w.sum -= removed;
+            }
+            sp.j = j, sp.next = b - n;
+        }
+        // The largest b whose leaves can fall on the sieve from byte first on.
+        std::uint64_t MaxB(const std::uint64_t first) const noexcept {
+            std::uint64_t bound = limit_;
+            if (first != 0) {
+                const std::uint64_t s = Isqrt(x_ / (30 * first));
+                if (s < bound) bound = s;
+            }
+            const std::uint64_t b = tables_.pi(bound);
+            return b < tables_.a() ? b : tables_.a() - 1;
+        }
+        void SieveChunk(const std::size_t worker, const std::uint64_t chunk, ChunkResult& res) {
+            const Tables& t = tables_;
+            Worker& w = workers_[worker];
+            const std::uint64_t total = z_ / 30 + 1, begin = chunk * ChunkSegments * SegmentBytes;
+            const std::uint64_t end = total - begin < ChunkSegments * SegmentBytes ? total : begin + ChunkSegments * SegmentBytes;
+            std::uint64_t bmax = MaxB(begin);
+            res.coefficient.assign(bmax + 1, 0), res.survivors.assign(bmax + 1, 0), res.local = 0;
+            if (w.next_chunk != chunk) {
+                // The first multiple p * q >= 30 * begin with q coprime to 30. q may be 1, because p itself is removed too.
+                w.primes.clear();
+                for (std::uint64_t b = 4; b <= bmax; ++b) {
+                    const std::uint64_t p = t.primes[b], lo = 30 * begin;
+                    std::uint64_t q = lo / p + (lo % p != 0);
+                    q += WheelSkip[q % 30];
+                    w.primes.push_back(SievingPrime{ static_cast<std::uint32_t>(p / 30), WheelIndex[p % 30], WheelIndex[q % 30], p * q / 30 - begin });
+                }
+            }
+            w.primes.resize(bmax - 3), w.next_chunk = chunk + 1;
+            for (std::uint64_t first = begin; first < end; first += SegmentBytes) {
+                const std::size_t n = static_cast<std::size_t>(end - first < SegmentBytes ? end - first : std::uint64_t(SegmentBytes));
+                std::uint8_t* const buf = w.buffer.data();
+                std::memset(buf, 0xff, n);
+                std::memset(buf + n, 0, w.buffer.size() - n);
+                if (first + n == total)
+                    for (std::int32_t k = 0; k != 8; ++k)
+                        if (WheelResidues[k] > z_ % 30) buf[n - 1] &= static_cast<std::uint8_t>(~(1u << k));
+                w.sum = 0;
+                for (std::size_t i = 0; i != w.blocks.size(); ++i) {
+                    T s = 0;
+                    for (std::size_t k = i * BlockBytes; k < (i + 1) * BlockBytes && k < n; k += 8) s += Weight::Word(LoadSieveWord(buf + k), first + k);
+                    w.blocks[i] = s, w.sum += s;
+                }
+                const std::uint64_t b_end = MaxB(first);
+                if (b_end < bmax) bmax = b_end, w.primes.resize(bmax - 3);
+                for (std::uint64_t b = 4; b <= C; ++b) Cross(w, w.primes[b - 4], first, n);
+                const std::uint64_t lo = 30 * first, hi = 30 * (first + n);
+                for (std::uint64_t b = C + 1; b <= bmax; ++b) {
+                    const std::uint64_t p = t.primes[b], xp = x_ / p, m0 = p > y_ / p ? p : y_ / p;
+                    const std::uint64_t bound = p * p < y_ + 1 ? p * p : y_ + 1;
+                    std::uint64_t m_hi = xp / bound;  // below m_easy
+                    if (m_hi > y_) m_hi = y_;
+                    if (lo != 0 && xp / lo < m_hi) m_hi = xp / lo;
+                    const std::uint64_t m_lo = xp / hi > m0 ? xp / hi : m0;
+                    if (m_lo < m_hi) {
+                        Query q;
+                        T coefficient = 0, local = 0;
+                        const T base = res.survivors[b];
+                        if (p * p <= y_) {
+                            for (std::uint64_t m = m_hi | 1; m > m_lo; m -= 2) {
+                                if (m > m_hi) continue;
+                                const std::int32_t f = t.factor[m / 2];
+                                if (f == 0 || (f > 0 ? f : -f) <= static_cast<std::int64_t>(p)) continue;
+                                const T weight = Weight::Of(p) * Weight::Of(m), leaf = f > 0 ? 0 - weight : weight;
+                                coefficient += leaf, local += leaf * (base + Count(w, q, first, xp / m));
+                            }
+                        } else {
+                            for (std::uint64_t j = t.pi(m_hi); t.primes[j] > m_lo; --j) {
+                                const std::uint64_t m = t.primes[j];
+                                const T leaf = Weight::Of(p) * Weight::Of(m);
+                                coefficient += leaf, local += leaf * (base + Count(w, q, first, xp / m));
+                            }
+                        }
+                        res.coefficient[b] += coefficient, res.local += local;
+                    }
+                    res.survivors[b] += w.sum;
+                    Cross(w, w.primes[b - 4], first, n);
+                }
+            }
+        }
+        T HardLeaves() {
+            const std::uint64_t total = z_ / 30 + 1, chunk_bytes = ChunkSegments * SegmentBytes;
+            const std::uint32_t chunks = static_cast<std::uint32_t>((total + chunk_bytes - 1) / chunk_bytes);
+            const std::uint32_t wave = static_cast<std::uint32_t>(8 * pool_.size());
+            std::vector<ChunkResult> results(wave);
+            std::vector<T> phi(MaxB(0) + 1);
+            T res = 0;
+            for (std::uint32_t base = 0; base < chunks; base += wave) {
+                const std::uint32_t count = chunks - base < wave ? chunks - base : wave;
+                auto task = [&](const std::size_t worker, const std::uint32_t index, std::uint32_t) { SieveChunk(worker, base + index, results[index]); };
+                pool_.Run(count, task);
+                for (std::uint32_t i = 0; i != count; ++i) {
+                    const ChunkResult& r = results[i];
+                    res += r.local;
+                    for (std::size_t b = C + 1; b < r.coefficient.size(); ++b) res += r.coefficient[b] * phi[b], phi[b] += r.survivors[b];
+                }
+            }
+            return res;
+        }
+        // P2 = sum of w(p) * (S(x / p) - S(p - 1)) over the primes y < p <= sqrt(x), where S is the weight of the primes up to its argument.
+        T P2() {
+            const std::uint64_t s = Isqrt(x_);
+            if (s <= y_) return 0;
+            // The second part, together with S(s - 1).
+            T below = tables_.prefix[tables_.a()], second = 0;
+            const auto add = [&](const std::uint64_t p) {
+                const T wp = Weight::Of(p);
+                second += wp * below, below += wp;
+            };
+            ForEachPrime(y_ + 1, s + 1, add);
+            if (IsPrime(s)) below -= Weight::Of(s);
+            // The first part: the chunks of [s, z] are sieved in parallel, and each one handles the primes p with x / p in it.
+            struct Part {
+                T total = 0, weight = 0, local = 0;
+            };
+            const std::uint64_t width = 30 * (std::uint64_t(1) << 22), chunks = (z_ + 1 - s + width - 1) / width;
+            const std::uint32_t wave = static_cast<std::uint32_t>(8 * pool_.size());
+            std::vector<Part> parts(wave);
+            std::vector<PrimeSieveWorker> sieves(pool_.size());
+            std::vector<std::vector<std::uint64_t>> targets(pool_.size());
+            T first = 0;
+            for (std::uint64_t base = 0; base < chunks; base += wave) {
+                const std::uint32_t count = static_cast<std::uint32_t>(chunks - base < wave ? chunks - base : wave);
+                auto task = [&](const std::size_t worker, const std::uint32_t index, std::uint32_t) {
+                    const std::uint64_t lo = s + (base + index) * width, hi = z_ + 1 - lo < width ? z_ + 1 : lo + width;
+                    Part& part = parts[index];
+                    part = Part();
+                    std::vector<std::uint64_t>& ps = targets[worker];
+                    ps.clear();
+                    const std::uint64_t p_lo = x_ / hi + 1 > y_ + 1 ? x_ / hi + 1 : y_ + 1, p_hi = x_ / lo < s ? x_ / lo : s;
+                    const auto push = [&ps](const std::uint64_t p) { ps.push_back(p); };
+                    if (p_lo <= p_hi) ForEachPrime(p_lo, p_hi + 1, push);
+                    PrimeSieveWorker& sieve = sieves[worker];
+                    sieve.reset(lo, hi, SegmentBytes);
+                    constexpr std::uint8_t residues_upto[30] = { 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 4, 4, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 8 };
+                    for (std::size_t n; (n = sieve.next()) != 0;) {
+                        const std::uint64_t start = sieve.first(), stop = start + n;
+                        std::uint64_t word = 0;
+                        T running = part.total;
+                        // The targets x / p in this segment, in increasing order.
+                        while (!ps.empty() && x_ / ps.back() / 30 < stop) {
+                            const std::uint64_t v = x_ / ps.back(), pos = v / 30 - start, shift = 8 * (pos % 8);
+                            for (; word != pos / 8; ++word) running += Weight::Word(LoadSieveWord(sieve.data() + 8 * word), start + 8 * word);
+                            const std::uint64_t mask = ((std::uint64_t(1) << shift) - 1) | ((std::uint64_t(1) << residues_upto[v % 30]) - 1) << shift;
+                            const T wp = Weight::Of(ps.back());
+                            part.weight += wp, part.local += wp * (running + Weight::Word(LoadSieveWord(sieve.data() + 8 * (pos / 8)) & mask, start + 8 * (pos / 8)));
+                            ps.pop_back();
+                        }
+                        for (std::size_t k = 0; k < n; k += 8) part.total += Weight::Word(LoadSieveWord(sieve.data() + k), start + k);
+                    }
+                };
+                pool_.Run(count, task);
+                for (std::uint32_t i = 0; i != count; ++i) first += parts[i].local + parts[i].weight * below, below += parts[i].total;
+            }
+            return first - second;
+        }
+    public:
+        PrimePiLMO(const std::uint64_t x, const std::size_t threads) : x_(x), y_(ChooseY(x)), z_(x / y_), tables_(y_), pool_(threads), workers_(pool_.size()) {
+            const std::uint64_t r = Isqrt(z_), q = Isqrt(Isqrt(x));
+            limit_ = r > q ? r : q;
+            phi_count_.resize(Primorial), phi_weight_.resize(Primorial);
+            std::uint16_t count = 0;
+            T weight = 0;
+            for (std::uint32_t n = 0; n != Primorial; ++n) {
+                if (n % 2 != 0 && n % 3 != 0 && n % 5 != 0 && n % 7 != 0 && n % 11 != 0 && n % 13 != 0) ++count, weight += n;
+                phi_count_[n] = count, phi_weight_[n] = weight;
+            }
+        }
+        T Run() {
+            const Tables& t = tables_;
+            T phi = OrdinaryLeaves();
+            std::vector<T> easy(pool_.size());
+            const std::uint32_t a = static_cast<std::uint32_t>(t.a());
+            auto task = [&](const std::size_t worker, const std::uint32_t b, std::uint32_t) {
+                if (b > C) easy[worker] += EasyLeaves(b);
+            };
+            pool_.Run(a, task);
+            for (const T e : easy) phi += e;
+            phi += HardLeaves();
+            return phi + (Weight::Sum ? t.prefix[t.a()] : t.a()) - 1 - P2();
+        }
+    };
+
+}  // namespace internal
+
+// Returns the number of primes up to x, using threads threads (one per hardware thread if threads == 0).
+inline std::uint64_t PrimePi(const std::uint64_t x, const std::size_t threads = 0) {
+    if (x < (std::uint64_t(1) << 24)) return PrimeRange(0, x + 1).count();
+    return internal::PrimePiLMO<internal::CountWeight>(x, threads).Run();
+}
+
+#if defined(__SIZEOF_INT128__)
+// Returns the sum of the primes up to x, using threads threads (one per hardware thread if threads == 0).
+inline unsigned __int128 PrimeSum(const std::uint64_t x, const std::size_t threads = 0) {
+    if (x < (std::uint64_t(1) << 24)) {
+        unsigned __int128 res = 0;
+        ForEachPrime(0, x + 1, [&res](const std::uint64_t p) { res += p; });
+        return res;
+    }
+    return internal::PrimePiLMO<internal::SumWeight>(x, threads).Run();
+}
+#endif
+
+}  // namespace cppr
+
+#endif
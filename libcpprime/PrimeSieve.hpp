@@ -0,0 +1,356 @@
+/**
+ * libcpprime PrimeSieve.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#include "./IsPrime.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_PRIME_SIEVE
+#define LIBCPPRIME_INCLUDED_PRIME_SIEVE
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace cppr {
+
+namespace internal {
+
+    // Each byte of the sieve covers 30 consecutive integers, and bit k stands for 30 * byte + WheelResidues[k].
+    constexpr std::uint8_t WheelResidues[8] = { 1, 7, 11, 13, 17, 19, 23, 29 };
+    constexpr std::uint8_t WheelIndex[30] = { 8, 0, 8, 8, 8, 8, 8, 1, 8, 8, 8, 2, 8, 3, 8, 8, 8, 4, 8, 5, 8, 8, 8, 6, 8, 8, 8, 8, 8, 7 };
+    constexpr std::uint8_t WheelDelta[8] = { 6, 4, 2, 4, 2, 4, 6, 2 };
+    // Distance from r to the next residue coprime to 30.
+    constexpr std::uint8_t WheelSkip[30] = { 1, 0, 5, 4, 3, 2, 1, 0, 3, 2, 1, 0, 1, 0, 3, 2, 1, 0, 1, 0, 3, 2, 1, 0, 5, 4, 3, 2, 1, 0 };
+    // For p = 30 * a + WheelResidues[i] and q % 30 == WheelResidues[j], p * q lies on bit WheelBit[i][j] of its byte,
+    // and p * (q + WheelDelta[j]) lies a * WheelDelta[j] + WheelCarry[i][j] bytes further.
+    constexpr std::uint8_t WheelBit[8][8] = {
+        { 0, 1, 2, 3, 4, 5, 6, 7 }, { 1, 5, 4, 0, 7, 3, 2, 6 }, { 2, 4, 0, 6, 1, 7, 3, 5 }, { 3, 0, 6, 5, 2, 1, 7, 4 },
+        { 4, 7, 1, 2, 5, 6, 0, 3 }, { 5, 3, 7, 1, 6, 0, 4, 2 }, { 6, 2, 3, 7, 0, 4, 5, 1 }, { 7, 6, 5, 4, 3, 2, 1, 0 },
+    };
+    constexpr std::uint8_t WheelCarry[8][8] = {
+        { 0, 0, 0, 0, 0, 0, 0, 1 }, { 1, 1, 1, 0, 1, 1, 1, 1 }, { 2, 2, 0, 2, 0, 2, 2, 1 }, { 3, 1, 1, 2, 1, 1, 3, 1 },
+        { 3, 3, 1, 2, 1, 3, 3, 1 }, { 4, 2, 2, 2, 2, 2, 4, 1 }, { 5, 3, 1, 4, 1, 3, 5, 1 }, { 6, 4, 2, 4, 2, 4, 6, 1 },
+    };
+
+    inline std::uint64_t LoadSieveWord(const std::uint8_t* p) noexcept {
+        std::uint64_t w = 0;
+        for (std::int32_t k = 0; k != 8; ++k) w |= static_cast<std::uint64_t>(p[k]) << (8 * k);
+        return w;
+    }
+
+    // Sieves the integers in [lo, hi) that are coprime to 30 by the primes up to min(sqrt(hi - 1), sieve_limit), one segment at a time.
+    // Memory use is O(segment size + pi(sqrt(hi)) / segment count): sieving primes above 65536 are produced
+    // on demand by a second sieve, and those spanning more than one segment are kept in circular buckets
+    // and only touch the segments they actually hit.
+    class SegmentedSieve {
+        struct SmallPrime {
+            std::uint32_t wheel, j;  // wheel is p / 30 << 3 | WheelIndex[p % 30]
+            std::uint64_t next;      // byte offset of the next multiple from the current segment
+        };
+        struct BucketPrime {
+            std::uint32_t wheel, pos;  // pos is the byte offset in the target segment << 3 | j
+        };
+        std::uint64_t lo_ = 0, hi_ = 0, begin_ = 0, end_ = 0, current_ = 0, next_ = 0, limit_ = 0;
+        std::uint32_t shift_ = 0, pending_ = 0, base_next_ = 7;
+        bool complete_ = true;
+        std::vector<std::uint8_t> buffer_;
+        std::vector<SmallPrime> small_;
+        std::vector<std::vector<BucketPrime>> buckets_;
+        std::unique_ptr<SegmentedSieve> inner_;
+        std::size_t inner_size_ = 0, inner_pos_ = 0;
+        std::uint64_t inner_bits_ = 0, inner_byte_ = 0;
+        std::uint32_t NextSievingPrime() {
+            const std::uint32_t base_limit = limit_ < 65536 ? static_cast<std::uint32_t>(limit_) : 65535;
+            while (base_next_ <= base_limit) {
+                const std::uint32_t p = base_next_;
+                base_next_ += 2;
+                if (IsPrime16(p)) return p;
+            }
+            if (limit_ < 65536) return 0;
+            while (inner_bits_ == 0) {
+                if (inner_pos_ >= inner_size_) {
+                    inner_size_ = inner_->next(), inner_pos_ = 0;
+                    if (inner_size_ == 0) return 0;
+                }
+                inner_byte_ = inner_->first() + inner_pos_;
+                inner_bits_ = LoadSieveWord(inner_->data() + inner_pos_);
+                inner_pos_ += 8;
+            }
+            const std::int32_t k = CountrZero(inner_bits_);
+            inner_bits_ &= inner_bits_ - 1;
+            return static_cast<std::uint32_t>(30 * (inner_byte_ + (k >> 3)) + WheelResidues[k & 7]);
+        }
+        // Registers every pending sieving prime whose first multiple in range falls before the end of the bucket ring.
+        void Activate() {
+            const std::uint64_t ring = buckets_.size() << shift_;
+            for (; pending_ != 0; pending_ = NextSievingPrime()) {
+                // The first multiple p * q to cross is the smallest one with q >= p coprime to 30 that is not below lo.
+                // It is tracked as its distance from lo, which cannot overflow even near 2^64.
+                const std::uint64_t p = pending_;
+                std::uint64_t q = p, distance = p * p - lo_;
+                if (p * p < lo_) {
+                    q = lo_ / p, distance = lo_ % p;
+                    if (distance != 0) ++q, distance = p - distance;
+                }
+                const std::uint32_t skip = WheelSkip[q % 30];
+                q += skip, distance += skip * p;
+                if (distance > hi_ - 1 - lo_) continue;
+                const std::uint64_t byte = (lo_ + distance) / 30;
+                const std::uint32_t wheel = static_cast<std::uint32_t>(p / 30 << 3 | WheelIndex[p % 30]), j = WheelIndex[q % 30];
+                if ((p / 30) >> shift_ == 0) small_.push_back(SmallPrime{ wheel, j, byte - current_ });
+                else {
+                    if (byte - current_ >= ring) break;
+                    const std::uint64_t offset = byte - begin_;
+                    buckets_[(offset >> shift_) % buckets_.size()].push_back(BucketPrime{ wheel, static_cast<std::uint32_t>((offset & ((1ull << shift_) - 1)) << 3 | j) });
+                }
+            }
+        }
+    public:
+        static constexpr std::size_t MinSegmentBytes = 64, MaxSegmentBytes = std::size_t(1) << 24;
+        // The segment size actually used: segment_bytes rounded down to a power of two in [MinSegmentBytes, MaxSegmentBytes].
+        static std::size_t RoundSegmentBytes(const std::size_t segment_bytes) noexcept {
+            std::size_t size = MinSegmentBytes;
+            while (size < MaxSegmentBytes && size * 2 <= segment_bytes) size *= 2;
+            return size;
+        }
+        SegmentedSieve() = default;
+        SegmentedSieve(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes, const std::uint64_t sieve_limit = ~std::uint64_t(0)) { reset(lo, hi, segment_bytes, sieve_limit); }
+        // Starts over on a new range. The buffers keep their capacity, so sieving many ranges of similar size does not allocate.
+        void reset(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes, const std::uint64_t sieve_limit = ~std::uint64_t(0)) {
+            lo_ = lo, hi_ = hi, shift_ = 0, pending_ = 0, base_next_ = 7, complete_ = true;
+            inner_size_ = inner_pos_ = 0, inner_bits_ = inner_byte_ = 0;
+            small_.clear();
+            for (std::vector<BucketPrime>& bucket : buckets_) bucket.clear();
+            while ((std::size_t(1) << shift_) != RoundSegmentBytes(segment_bytes)) ++shift_;
+            begin_ = current_ = next_ = end_ = limit_ = 0;
+            if (lo >= hi) return;
+            begin_ = current_ = next_ = lo / 30, end_ = (hi - 1) / 30 + 1;
+            limit_ = Isqrt(hi - 1);
+            if (limit_ > sieve_limit) limit_ = sieve_limit, complete_ = false;
+            buffer_.resize(std::size_t(1) << shift_);
+            // A multiple of a bucket prime is at most 7 * p / 30 + 1 bytes away from the previous one or from lo.
+            // The ring never needs more buckets than there are segments.
+            const std::uint64_t ring = ((7 * (limit_ / 30) + 8) >> shift_) + 2, segments = ((end_ - begin_ - 1) >> shift_) + 1;
+            buckets_.resize(static_cast<std::size_t>(ring < segments ? ring : segments));
+            if (limit_ >= 65536) {
+                if (!inner_) inner_.reset(new SegmentedSieve());
+                inner_->reset(65536, limit_ + 1, segment_bytes);
+            }
+            pending_ = NextSievingPrime();
+        }
+        // Sieves the next segment and returns its length in bytes, or 0 once the range is exhausted.
+        std::size_t next() {
+            if (next_ >= end_) return 0;
+            current_ = next_;
+            next_ += std::uint64_t(1) << shift_;
+            const std::size_t n = end_ - current_ < (std::uint64_t(1) << shift_) ? static_cast<std::size_t>(end_ - current_) : std::size_t(1) << shift_;
+            std::uint8_t* const buf = buffer_.data();
+            std::memset(buf, 0xff, n);
+            std::memset(buf + n, 0, buffer_.size() - n);
+            Activate();
+            for (SmallPrime& sp : small_) {
+                std::uint64_t b = sp.next;
+                if (b < n) {
+                    const std::uint32_t a = sp.wheel >> 3, i = sp.wheel & 7;
+                    std::uint32_t j = sp.j;
+                    while (j != 0 && b < n) {
+                        buf[b] &= static_cast<std::uint8_t>(~(1u << WheelBit[i][j]));
+                        b += a * WheelDelta[j] + WheelCarry[i][j];
+                        j = (j + 1) & 7;
+                    }
+                    if (j == 0) {
+                        // The eight multiples of p in one turn of the wheel are p bytes long and always have the same offsets.
+                        const std::uint64_t p = 30 * a + WheelResidues[i];
+                        const std::uint64_t o1 = a * 6 + WheelCarry[i][0], o2 = o1 + a * 4 + WheelCarry[i][1], o3 = o2 + a * 2 + WheelCarry[i][2];
+                        const std::uint64_t o4 = o3 + a * 4 + WheelCarry[i][3], o5 = o4 + a * 2 + WheelCarry[i][4], o6 = o5 + a * 4 + WheelCarry[i][5];
+                        const std::uint64_t o7 = o6 + a * 6 + WheelCarry[i][6];
+                        const std::uint8_t* const bit = WheelBit[i];
+                        for (; b + o7 < n; b += p) {
+                            buf[b] &= static_cast<std::uint8_t>(~(1u << bit[0]));
+                            buf[b + o1] &= static_cast<std::uint8_t>(~(1u << bit[1]));
+                            buf[b + o2] &= static_cast<std::uint8_t>(~(1u << bit[2]));
+                            buf[b + o3] &= static_cast<std::uint8_t>(~(1u << bit[3]));
+                            buf[b + o4] &= static_cast<std::uint8_t>(~(1u << bit[4]));
+                            buf[b + o5] &= static_cast<std::uint8_t>(~(1u << bit[5]));
+                            buf[b + o6] &= static_cast<std::uint8_t>(~(1u << bit[6]));
+                            buf[b + o7] &= static_cast<std::uint8_t>(~(1u << bit[7]));
+                        }
+                        while (b < n) {
+                            buf[b] &= static_cast<std::uint8_t>(~(1u << WheelBit[i][j]));
+                            b += a * WheelDelta[j] + WheelCarry[i][j];
+                            j = (j + 1) & 7;
+                        }
+                    }
+                    sp.j = j;
+                }
+                sp.next = b - n;
+            }
+            if (!buckets_.empty()) {
+                const std::uint64_t segment = (current_ - begin_) >> shift_;
+                const std::size_t count = buckets_.size();
+                std::vector<BucketPrime>& bucket = buckets_[segment % count];
+                for (const BucketPrime& bp : bucket) {
+                    const std::uint32_t a = bp.wheel >> 3, i = bp.wheel & 7, j = bp.pos & 7;
+                    const std::uint64_t offset = bp.pos >> 3;
+                    buf[offset] &= static_cast<std::uint8_t>(~(1u << WheelBit[i][j]));
+                    const std::uint64_t next = offset + std::uint64_t(a) * WheelDelta[j] + WheelCarry[i][j];
+                    if (next >= end_ - current_) continue;
+                    buckets_[(segment + (next >> shift_)) % count].push_back(BucketPrime{ bp.wheel, static_cast<std::uint32_t>((next & ((1ull << shift_) - 1)) << 3 | ((j + 1) & 7)) });
+                }
+                bucket.clear();
+            }
+            if (current_ == begin_) {
+                const std::uint32_t r = static_cast<std::uint32_t>(lo_ % 30);
+                for (std::int32_t k = 0; k != 8; ++k)
+                    if (WheelResidues[k] < r || (current_ == 0 && k == 0)) buf[0] &= static_cast<std::uint8_t>(~(1u << k));
+            }
+            if (current_ + n == end_) {
+                const std::uint32_t r = static_cast<std::uint32_t>((hi_ - 1) % 30);
+                for (std::int32_t k = 0; k != 8; ++k)
+                    if (WheelResidues[k] > r) buf[n - 1] &= static_cast<std::uint8_t>(~(1u << k));
+            }
+            return n;
+        }
+        // Whether the set bits are exactly the primes, or only candidates free of factors up to sieve_limit.
+        bool complete() const noexcept { return complete_; }
+        std::size_t segment_bytes() const noexcept { return buffer_.size(); }
+        // Index of the first byte of the segment returned by the last call to next().
+        std::uint64_t first() const noexcept { return current_; }
+        // The sieved segment, padded with zero bytes to the segment size.
+        const std::uint8_t* data() const noexcept { return buffer_.data(); }
+        std::uint8_t* data() noexcept { return buffer_.data(); }
+    };
+
+    // Calls f for every set bit in n bytes of sieve data starting at byte index first.
+    template<class F> void ForEachSievedPrime(const std::uint8_t* data, const std::size_t n, const std::uint64_t first, F& f) {
+        for (std::size_t i = 0; i < n; i += 8) {
+            std::uint64_t w = LoadSieveWord(data + i);
+            while (w != 0) {
+                const std::int32_t k = CountrZero(w);
+                w &= w - 1;
+                f(30 * (first + i + (k >> 3)) + WheelResidues[k & 7]);
+            }
+        }
+    }
+
+    // Setting up the sieving primes up to B costs about as much as B / 100 primality tests,
+    // so narrow windows are only sieved up to a few times their width and the survivors are tested with IsPrimeBatch.
+    // Below NarrowWindow numbers even that setup does not pay off.
+    constexpr std::uint64_t NarrowWindow = 4096;
+    inline std::uint64_t SieveLimit(const std::uint64_t lo, const std::uint64_t hi) noexcept {
+        const std::uint64_t width = hi - lo;
+        return width < 16384 ? 65535 : width < (1ull << 61) ? 4 * width : ~std::uint64_t(0);
+    }
+
+    // Sieves one range after another with the same buffers, so that the steady state does not allocate.
+    // Segments of narrow ranges are only sieved up to SieveLimit, and the survivors are confirmed with IsPrimeBatch,
+    // so the bits returned by next() are always exactly the primes.
+    class PrimeSieveWorker {
+        SegmentedSieve sieve_;
+        std::vector<std::uint64_t> candidates_;
+        std::vector<std::uint32_t> positions_;
+        std::unique_ptr<bool[]> result_;
+        std::size_t result_size_ = 0;
+        void Confirm(const std::size_t n) {
+            if (result_size_ < 8 * n) result_.reset(new bool[result_size_ = 8 * sieve_.segment_bytes()]);
+            candidates_.clear(), positions_.clear();
+            std::uint8_t* const data = sieve_.data();
+            for (std::size_t i = 0; i < n; i += 8) {
+                for (std::uint64_t w = LoadSieveWord(data + i); w != 0; w &= w - 1) {
+                    const std::int32_t k = CountrZero(w);
+                    candidates_.push_back(30 * (sieve_.first() + i + (k >> 3)) + WheelResidues[k & 7]);
+                    positions_.push_back(static_cast<std::uint32_t>(8 * i + k));
+                }
+            }
+            IsPrimeBatch(candidates_.data(), candidates_.size(), result_.get());
+            for (std::size_t i = 0; i != candidates_.size(); ++i)
+                if (!result_[i]) data[positions_[i] >> 3] &= static_cast<std::uint8_t>(~(1u << (positions_[i] & 7)));
+        }
+        // Returns false when [lo, hi) was handled without the sieve, and otherwise resets the sieve to it.
+        template<class F> bool Start(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes, F& f) {
+            if (lo >= hi) return false;
+            if (hi - lo < NarrowWindow) {
+                for (std::uint64_t x = lo; x != hi; ++x)
+                    if (IsPrime(x)) f(x);
+                return false;
+            }
+            const std::uint64_t small[3] = { 2, 3, 5 };
+            for (const std::uint64_t p : small)
+                if (lo <= p && p < hi) f(p);
+            reset(lo, hi, segment_bytes);
+            return true;
+        }
+    public:
+        // Like SegmentedSieve::reset with the sieving bound chosen by SieveLimit. 2, 3 and 5 are never reported.
+        void reset(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes) { sieve_.reset(lo, hi, segment_bytes, SieveLimit(lo, hi)); }
+        std::size_t next() {
+            const std::size_t n = sieve_.next();
+            if (n != 0 && !sieve_.complete()) Confirm(n);
+            return n;
+        }
+        std::uint64_t first() const noexcept { return sieve_.first(); }
+        const std::uint8_t* data() const noexcept { return sieve_.data(); }
+        std::uint64_t count(const std::size_t n) const noexcept {
+            std::uint64_t res = 0;
+            for (std::size_t i = 0; i < n; i += 8) res += Popcount(LoadSieveWord(sieve_.data() + i));
+            return res;
+        }
+        template<class F> void ForEach(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes, F& f) {
+            if (!Start(lo, hi, segment_bytes, f)) return;
+            for (std::size_t n; (n = next()) != 0;) ForEachSievedPrime(data(), n, first(), f);
+        }
+        std::uint64_t Count(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes) {
+            std::uint64_t res = 0;
+            const auto increment = [&res](std::uint64_t) { ++res; };
+            if (!Start(lo, hi, segment_bytes, increment)) return res;
+            for (std::size_t n; (n = next()) != 0;) res += count(n);
+            return res;
+        }
+    };
+
+}  // namespace internal
+
+class PrimeRange {
+    std::uint64_t lo_, hi_;
+    std::size_t segment_bytes_;
+public:
+    // 32 KiB fits in the L1 data cache of most x86-64 and ARM cores.
+    static constexpr std::size_t DefaultSegmentBytes = 32768;
+    PrimeRange(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes = DefaultSegmentBytes) noexcept : lo_(lo), hi_(hi), segment_bytes_(segment_bytes) {}
+    std::uint64_t lo() const noexcept { return lo_; }
+    std::uint64_t hi() const noexcept { return hi_; }
+    template<class F> void for_each(F&& f) const { internal::PrimeSieveWorker().ForEach(lo_, hi_, segment_bytes_, f); }
+    std::uint64_t count() const { return internal::PrimeSieveWorker().Count(lo_, hi_, segment_bytes_); }
+};
+
+// Calls f with every prime in [lo, hi) in increasing order.
+template<class F> void ForEachPrime(const std::uint64_t lo, const std::uint64_t hi, F&& f, const std::size_t segment_bytes = PrimeRange::DefaultSegmentBytes) {
+    PrimeRange(lo, hi, segment_bytes).for_each(f);
+}
+
+}  // namespace cppr
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * libcpprime PrimeView.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#include "./NextPrime.hpp"
+#include "./PrimeSieve.hpp"
+#include <cstddef>
+#include <iterator>
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<ranges>)
+#include <ranges>
+#endif
+#endif
+
+#ifndef LIBCPPRIME_INCLUDED_PRIME_VIEW
+#define LIBCPPRIME_INCLUDED_PRIME_VIEW
+
+namespace cppr {
+
+namespace internal {
+
+#ifdef __cpp_lib_ranges
+    using PrimeViewBase = std::ranges::view_base;
+#else
+    struct PrimeViewBase {};
+#endif
+
+}  // namespace internal
+
+// A lazy range of the primes in [lo, hi) in increasing order, which is an input range and, in C++20, a std::ranges::view.
+// The first primes come from NextPrime, so taking a few primes after a huge starting point costs a few tests each.
+// After that, windows of the range are handed to a segmented sieve. The windows start at 4096 numbers and double up to 2^20,
+// and the rest of the range becomes a single window once 4 times the window width reaches sqrt(hi).
+// Each window is sieved up to 4 times its width, and the survivors of an incomplete sieve are confirmed with IsPrimeBatch,
+// so the memory use is bounded independently of the range and the work per prime is amortized O(log log n) on dense ranges.
+// Iterators refer to the view, which must outlive them and must not be moved while they are in use.
+class PrimeView : public internal::PrimeViewBase {
+    static constexpr std::uint32_t NextPrimeCount = 64;
+    static constexpr std::uint64_t MinWidth = 4096, MaxWidth = 1 << 20;
+    std::uint64_t lo_ = 0, hi_ = 0, current_ = 0;
+    std::size_t segment_bytes_ = PrimeRange::DefaultSegmentBytes;
+    internal::PrimeSieveWorker worker_;
+    std::uint64_t window_hi_ = 0, width_ = MinWidth, word_ = 0, word_byte_ = 0;
+    std::size_t segment_size_ = 0, segment_pos_ = 0;
+    std::uint32_t found_ = 0;
+    bool done_ = true, sieving_ = false;
+    void Advance() {
+        if (!sieving_) {
+            if (found_ != NextPrimeCount) {
+                const std::uint64_t p = NextPrime(current_ + 1);
+                ++found_;
+                if (p == 0 || p >= hi_) done_ = true;
+                else current_ = p;
+                return;
+            }
+            sieving_ = true, window_hi_ = current_ + 1;
+        }
+        while (true) {
+            if (word_ != 0) {
+                const std::int32_t k = internal::CountrZero(word_);
+                word_ &= word_ - 1;
+                current_ = 30 * (word_byte_ + (k >> 3)) + internal::WheelResidues[k & 7];
+                return;
+            }
+            if (segment_pos_ < segment_size_) {
+                word_ = internal::LoadSieveWord(worker_.data() + segment_pos_);
+                word_byte_ = worker_.first() + segment_pos_;
+                segment_pos_ += 8;
+                continue;
+            }
+            segment_size_ = worker_.next(), segment_pos_ = 0;
+            if (segment_size_ != 0) continue;
+            if (window_hi_ >= hi_) {
+                done_ = true;
+                return;
+            }
+            const std::uint64_t lo = window_hi_;
+            window_hi_ = (4 * width_) * (4 * width_) >= hi_ - 1 || hi_ - lo <= width_ ? hi_ : lo + width_;
+            width_ = width_ < MaxWidth ? 2 * width_ : MaxWidth;
+            worker_.reset(lo, window_hi_, segment_bytes_);
+        }
+    }
+public:
+    class iterator {
+        PrimeView* view_ = nullptr;
+        bool at_end() const noexcept { return view_ == nullptr || view_->done_; }
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::uint64_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::uint64_t*;
+        using reference = const std::uint64_t&;
+        iterator() = default;
+        explicit iterator(PrimeView* view) noexcept : view_(view) {}
+        reference operator*() const noexcept { return view_->current_; }
+        pointer operator->() const noexcept { return &view_->current_; }
+        iterator& operator++() {
+            view_->Advance();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        // An iterator equals the end once the view is exhausted.
+        friend bool operator==(const iterator& a, const iterator& b) noexcept { return a.at_end() == b.at_end(); }
+        friend bool operator!=(const iterator& a, const iterator& b) noexcept { return !(a == b); }
+    };
+    PrimeView() = default;
+    PrimeView(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes = PrimeRange::DefaultSegmentBytes) : lo_(lo), hi_(hi), segment_bytes_(segment_bytes) {}
+    std::uint64_t lo() const noexcept { return lo_; }
+    std::uint64_t hi() const noexcept { return hi_; }
+    // Starts over from lo. Iterators obtained earlier refer to the new pass.
+    iterator begin() {
+        sieving_ = false, found_ = 1, width_ = MinWidth, word_ = 0, segment_size_ = segment_pos_ = 0;
+        worker_.reset(0, 0, segment_bytes_);
+        current_ = lo_ < hi_ ? NextPrime(lo_) : 0;
+        done_ = current_ == 0 || current_ >= hi_;
+        return iterator(this);
+    }
+    iterator end() noexcept { return iterator(); }
+};
+
+// The primes in [lo, hi) as a lazy range, e.g. for (std::uint64_t p : cppr::primes(lo, hi)).
+inline PrimeView primes(const std::uint64_t lo, const std::uint64_t hi, const std::size_t segment_bytes = PrimeRange::DefaultSegmentBytes) { return PrimeView(lo, hi, segment_bytes); }
+
+}  // namespace cppr
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * libcpprime RandomPrime.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#include "./NextPrime.hpp"
+#include <random>
+
+#ifndef LIBCPPRIME_INCLUDED_RANDOM_PRIME
+#define LIBCPPRIME_INCLUDED_RANDOM_PRIME
+
+namespace cppr {
+
+namespace internal {
+
+    // Returns the candidates of the block at base (base % 210 == 0) in [lo, hi].
+    inline std::uint64_t RandomWindowCandidates(const std::uint64_t base, const std::uint64_t lo, const std::uint64_t hi) noexcept {
+        std::uint64_t candidates = WindowCandidates(base);
+        if (base < lo) candidates &= ~0ull << Wheel210Below[lo - base];
+        if (hi - base < 209) candidates &= (1ull << Wheel210Below[hi - base + 1]) - 1;
+        return candidates;
+    }
+
+}  // namespace internal
+
+// Returns a random prime with exactly bits bits (2 <= bits <= 64), or 0 if bits is out of range. Rng is a UniformRandomBitGenerator.
+// Up to 32 bits every prime of the range is equally likely. Above that, the first prime at or after a random point x is taken from the block of 210 around x,
+// wrapping around to the start of the block, so a prime is chosen with a probability proportional to its distance to the previous prime in the block.
+template<class Rng> std::uint64_t RandomPrime(const std::int32_t bits, Rng& rng) {
+    if (bits < 2 || bits > 64) return 0;
+    const std::uint64_t lo = 1ull << (bits - 1), hi = lo + (lo - 1);
+    std::uniform_int_distribution<std::uint64_t> dist(lo, hi);
+    if (bits <= 32) {
+        while (true) {
+            const std::uint64_t x = dist(rng) | (bits != 2);
+            if (IsPrime(x)) return x;
+        }
+    }
+    // The candidates in a block are sieved by the primes up to 743 at once, and only the survivors are tested.
+    while (true) {
+        const std::uint64_t x = dist(rng), base = x - x % 210;
+        const std::uint64_t candidates = internal::RandomWindowCandidates(base, lo, hi), upper = ~0ull << internal::Wheel210Below[x - base];
+        std::uint64_t res = internal::FirstWindowPrime<true>(base, candidates & upper);
+        if (res == 0) res = internal::FirstWindowPrime<true>(base, candidates & ~upper);
+        if (res != 0) return res;
+    }
+}
+
+// Returns a random safe prime p with exactly bits bits (3 <= bits <= 64), that is, both p and (p - 1) / 2 are prime, or 0 if bits is out of range.
+// The distribution is the same as that of RandomPrime.
+template<class Rng> std::uint64_t RandomSafePrime(const std::int32_t bits, Rng& rng) {
+    if (bits < 3 || bits > 64) return 0;
+    const std::uint64_t lo = 1ull << (bits - 1), hi = lo + (lo - 1);
+    std::uniform_int_distribution<std::uint64_t> dist(lo, hi);
+    if (bits <= 32) {
+        while (true) {
+            const std::uint64_t x = dist(rng) | 1;
+            // Above 7, p % 12 == 11 because neither p nor (p - 1) / 2 is divisible by 2 or 3.
+            if ((x % 12 == 11 || x < 12) && IsPrime(x >> 1) && IsPrime(x)) return x;
+        }
+    }
+    while (true) {
+        const std::uint64_t x = dist(rng), base = x - x % 210;
+        const std::uint64_t all = internal::RandomWindowCandidates(base, lo, hi);
+        const std::int32_t shift = internal::Wheel210Below[x - base];
+        std::uint64_t candidates = ((all >> shift) | (all << (48 - shift))) & ((1ull << 48) - 1);
+        while (candidates != 0) {
+            const std::int32_t k = (internal::CountrZero(candidates) + shift) % 48;
+            candidates &= candidates - 1;
+            const std::uint64_t p = base + internal::Wheel210[k], q = p >> 1;
+            if (p % 12 != 11 || internal::HasSmallFactor(q) || internal::HasMediumFactor(q)) continue;
+            if (internal::IsPrimeBits<63>(q) && IsPrime(p)) return p;
+        }
+    }
+}
+
+}  // namespace cppr
+
+#endif
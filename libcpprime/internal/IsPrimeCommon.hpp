@@ -43,6 +43,7 @@
 #ifndef LIBCPPRIME_INCLUDED_IS_PRIME_COMMON
 #define LIBCPPRIME_INCLUDED_IS_PRIME_COMMON
 
+#include <cstddef>
 #include <cstdint>
 #ifdef __has_include
 #if __has_include(<type_traits>)
@@ -71,6 +72,8 @@
 #define LIBCPPRIME_IF_CONSTEXPR
 #endif
 
+#include "./Stats.hpp"
+
 namespace cppr {
 
 namespace internal {
@@ -148,6 +151,18 @@ namespace internal {
         x |= x >> 16;
         x++;
         return offset + CountlZeroTable[(x * 0x076be629u) >> 27];
+#endif
+    }
+    LIBCPPRIME_CONSTEXPR std::int32_t Popcount(std::uint64_t n) noexcept {
+#ifdef __cpp_lib_bitops
+        return std::popcount(n);
+#elif defined(__GNUC__)
+        return __builtin_popcountll(n);
+#else
+        n = n - ((n >> 1) & 0x5555555555555555);
+        n = (n & 0x3333333333333333) + ((n >> 2) & 0x3333333333333333);
+        n = (n + (n >> 4)) & 0x0f0f0f0f0f0f0f0f;
+        return static_cast<std::int32_t>((n * 0x0101010101010101) >> 56);
 #endif
     }
     LIBCPPRIME_CONSTEXPR Int64Pair Mulu128(std::uint64_t muler, std::uint64_t mulnd) noexcept {
@@ -253,6 +268,17 @@ namespace internal {
         return x << l;
     }
 
+    LIBCPPRIME_CONSTEXPR std::uint64_t Isqrt(const std::uint64_t x) noexcept {
+        if (x < 2) return x;
+        const std::int32_t k = 32 - (CountlZero(x - 1) >> 1);
+        std::uint64_t s = 1ull << k, t = (s + (x >> k)) >> 1;
+        while (t < s) {
+            s = t;
+            t = (s + x / s) >> 1;
+        }
+        return s;
+    }
+
     template<bool Strict = false> class MontgomeryModint64Impl {
         std::uint64_t mod_ = 0, rs = 0, nr = 0, np = 0;
         LIBCPPRIME_CONSTEXPR std::uint64_t reduce(const std::uint64_t n) const noexcept {
@@ -280,6 +306,7 @@ namespace internal {
         }
 
     public:
+        MontgomeryModint64Impl() = default;
         LIBCPPRIME_CONSTEXPR MontgomeryModint64Impl(std::uint64_t n) noexcept {
             Assume(n > 2 && n % 2 != 0);
             mod_ = n;
@@ -288,6 +315,9 @@ namespace internal {
             for (std::uint32_t i = 0; i != 5; ++i) nr *= 2 - n * nr;
             np = reduce(rs);
         }
+        // Takes the constants precomputed for the modulus n: r2 = 2^128 mod n, inv = n^-1 mod 2^64 and r1 = 2^64 mod n.
+        constexpr MontgomeryModint64Impl(std::uint64_t n, std::uint64_t r2, std::uint64_t inv, std::uint64_t r1) noexcept : mod_(n), rs(r2), nr(inv), np(r1) {}
+        LIBCPPRIME_CONSTEXPR std::uint64_t mod() const noexcept { return mod_; }
         LIBCPPRIME_CONSTEXPR std::uint64_t build(std::uint32_t x) const noexcept { return reduce(x % mod_, rs); }
         LIBCPPRIME_CONSTEXPR std::uint64_t build(std::uint64_t x) const noexcept { return reduce(x % mod_, rs); }
         LIBCPPRIME_CONSTEXPR std::uint64_t raw(std::uint64_t x) const noexcept {
@@ -370,6 +400,113 @@ namespace internal {
         }
     };
 
+    // Calls f(0), ..., f(N - 1) through inlined calls with constant indices, so that the small arrays f indexes can be kept in registers.
+    template<std::int32_t N> struct Unroll {
+        template<class F> static LIBCPPRIME_CONSTEXPR void Run(F& f) noexcept {
+            Unroll<N - 1>::Run(f);
+            f(N - 1);
+        }
+    };
+    template<> struct Unroll<0> {
+        template<class F> static LIBCPPRIME_CONSTEXPR void Run(F&) noexcept {}
+    };
+
+    // Sets res[k] = bases[k]^ex for the K bases in the Montgomery form of the same modulus, for ex >= 1.
+    // The exponent is split once from the top into windows of at most 3 bits that end in a 1 bit, and all the bases follow that split together,
+    // so each base costs one squaring per bit plus one multiplication by a precomputed odd power per window, instead of one per set bit,
+    // and the K chains of squarings are independent of each other.
+    template<std::int32_t K, bool Strict> LIBCPPRIME_CONSTEXPR void PowShared(const MontgomeryModint64Impl<Strict>& mint, const std::uint64_t ex, const std::uint64_t* bases, std::uint64_t* res) noexcept {
+        constexpr std::int32_t W = 3;
+        LIBCPPRIME_STATS_ADD(squarings, K * (63 - CountlZero(ex)));
+        std::uint64_t table[K][1 << (W - 1)] = {}, a[K] = {};
+        for (std::int32_t k = 0; k != K; ++k) {
+            const std::uint64_t square = mint.mul(bases[k], bases[k]);
+            table[k][0] = bases[k];
+            for (std::int32_t j = 1; j != (1 << (W - 1)); ++j) table[k][j] = mint.mul(table[k][j - 1], square);
+        }
+        std::uint32_t digit = 0;
+        auto square = [&](const std::int32_t k) { a[k] = mint.mul(a[k], a[k]); };
+        auto multiply = [&](const std::int32_t k) { a[k] = mint.mul(a[k], table[k][digit]); };
+        // i is the highest bit not applied yet. The squarings for the zero bits above a window are done together with those of the window.
+        std::int32_t i = 63 - CountlZero(ex), low = i - W + 1 < 0 ? 0 : i - W + 1;
+        low += CountrZero(ex >> low);
+        digit = static_cast<std::uint32_t>(ex >> low) >> 1;
+        for (std::int32_t k = 0; k != K; ++k) a[k] = table[k][digit];
+        for (i = low - 1; i >= 0; i = low - 1) {
+            const std::uint64_t rest = ex & ((2ull << i) - 1);
+            if (rest == 0) low = 0;
+            else {
+                const std::int32_t top = 63 - CountlZero(rest);
+                low = top - W + 1 < 0 ? 0 : top - W + 1;
+                low += CountrZero(rest >> low);
+            }
+            for (std::int32_t j = i; j >= low; --j) Unroll<K>::Run(square);
+            if (rest == 0) break;
+            digit = static_cast<std::uint32_t>(rest >> low) >> 1;
+            Unroll<K>::Run(multiply);
+        }
+        for (std::int32_t k = 0; k != K; ++k) res[k] = a[k];
+    }
+
+    template<std::int32_t Lanes, std::int32_t K> LIBCPPRIME_CONSTEXPR void MillerRabinInterleaved(const std::uint64_t* x, const std::uint64_t (*bases)[K], bool* res) noexcept {
+        constexpr std::int32_t W = 2;
+        MontgomeryModint64Impl<true> mint[Lanes];
+        std::uint64_t one[Lanes] = {}, mone[Lanes] = {}, D[Lanes] = {};
+        std::uint64_t a[Lanes][K] = {}, table[Lanes][K][1 << W] = {};
+        std::int32_t S[Lanes] = {};
+        bool ok[Lanes][K] = {};
+        std::int32_t max_bits = 0, max_S = 0;
+        for (std::int32_t l = 0; l != Lanes; ++l) {
+            mint[l] = MontgomeryModint64Impl<true>(x[l]);
+            S[l] = CountrZero(x[l] - 1);
+            D[l] = (x[l] - 1) >> S[l];
+            const std::int32_t bits = 64 - CountlZero(D[l]);
+            max_bits = max_bits < bits ? bits : max_bits;
+            max_S = max_S < S[l] ? S[l] : max_S;
+            one[l] = mint[l].one(), mone[l] = mint[l].neg(one[l]);
+            for (std::int32_t k = 0; k != K; ++k) {
+                table[l][k][0] = one[l];
+                table[l][k][1] = mint[l].raw(bases[l][k]);
+                for (std::int32_t j = 2; j != (1 << W); ++j) table[l][k][j] = mint[l].mul(table[l][k][j - 1], table[l][k][1]);
+            }
+        }
+        // The exponents are scanned from the top in fixed windows, so every lane performs the same branch-free sequence of multiplications
+        // and Lanes * K independent chains are in flight at once.
+        std::int32_t pos = (max_bits + W - 1) / W * W - W;
+        for (std::int32_t l = 0; l != Lanes; ++l) {
+            const std::uint64_t digit = (D[l] >> pos) & ((1 << W) - 1);
+            for (std::int32_t k = 0; k != K; ++k) a[l][k] = table[l][k][digit];
+        }
+        while (pos != 0) {
+            pos -= W;
+            for (std::int32_t l = 0; l != Lanes; ++l) {
+                const std::uint64_t digit = (D[l] >> pos) & ((1 << W) - 1);
+                for (std::int32_t k = 0; k != K; ++k) {
+                    for (std::int32_t j = 0; j != W; ++j) a[l][k] = mint[l].mul(a[l][k], a[l][k]);
+                    a[l][k] = mint[l].mul(a[l][k], table[l][k][digit]);
+                }
+            }
+        }
+        for (std::int32_t l = 0; l != Lanes; ++l) {
+            res[l] = true;
+            for (std::int32_t k = 0; k != K; ++k) {
+                ok[l][k] = mint[l].same(a[l][k], one[l]) || mint[l].same(a[l][k], mone[l]);
+                res[l] &= ok[l][k];
+            }
+        }
+        for (std::int32_t i = 0; i < max_S - 1; ++i) {
+            for (std::int32_t l = 0; l != Lanes; ++l) {
+                if (res[l] || i >= S[l] - 1) continue;
+                res[l] = true;
+                for (std::int32_t k = 0; k != K; ++k) {
+                    a[l][k] = mint[l].mul(a[l][k], a[l][k]);
+                    ok[l][k] |= mint[l].same(a[l][k], mone[l]);
+                    res[l] &= ok[l][k];
+                }
+            }
+        }
+    }
+
     // clang-format off
 	constexpr std::uint16_t Bases[256] = {
 1216,1836,8885,4564,10978,5228,15613,13941,1553,173,3615,3144,10065,9259,233,2362,6244,6431,10863,5920,6408,6841,22124,2290,45597,6935,4835,7652,1051,445,5807,842,1534,22140,1282,1733,347,6311,14081,11157,186,703,9862,15490,1720,17816,10433,49185,2535,9158,2143,2840,664,29074,24924,1035,41482,1065,10189,8417,130,4551,5159,48886,
@@ -377,16 +514,42 @@ namespace internal {
 5411,35353,50898,1084,2127,4305,115,7821,1265,16169,1705,1857,24938,220,3650,1057,482,1690,2718,4309,7496,1515,7972,3763,10954,2817,3430,1423,714,6734,328,2581,2580,10047,2797,155,5951,3817,54850,2173,1318,246,1807,2958,2697,337,4871,2439,736,37112,1226,527,7531,5418,7242,2421,16135,7015,8432,2605,5638,5161,11515,14949,
 748,5003,9048,4679,1915,7652,9657,660,3054,15469,2910,775,14106,1749,136,2673,61814,5633,1244,2567,4989,1637,1273,11423,7974,7509,6061,531,6608,1088,1627,160,6416,11350,921,306,18117,1238,463,1722,996,3866,6576,6055,130,24080,7331,3922,8632,2706,24108,32374,4237,15302,287,2296,1220,20922,3350,2089,562,11745,163,11951 };
     // clang-format on
-    LIBCPPRIME_CONSTEXPR bool IsPrime32(const std::uint32_t x) noexcept {
+    LIBCPPRIME_CONSTEXPR bool HasSmallFactor(const std::uint64_t n) noexcept {
+        return (n & 1) == 0 || 6148914691236517205u >= 12297829382473034411u * n || 3689348814741910323u >= 14757395258967641293u * n || 2635249153387078802u >= 7905747460161236407u * n || 1676976733973595601u >= 3353953467947191203u * n || 1418980313362273201u >= 5675921253449092805u * n || 1085102592571150095u >= 17361641481138401521u * n;
+    }
+    // The inverses modulo 2^64 of the 64 odd primes from 19 to 353 and (2^64 - 1) / p, so that p divides n if and only if n * inverse <= limit.
+    constexpr std::uint64_t TrialDivisionInverse[64] = { 9708812670373448219u, 15238614669586151335u, 3816567739388183093u, 17256631552825064415u, 1495681951922396077u, 10348173504763894809u, 9437869060967677571u, 5887258746928580303u, 2436362424829563421u, 14694863923124558067u, 5745707170499696405u, 17345445920055250027u, 1818693077689674103u, 9097024474706080249u, 11208148297950107311u, 11779246215742243803u, 17617676924329347049u, 11790702397628785569u, 4200743699953660269u, 15760325033848937303u, 8619973866219416643u, 12015769075535579493u, 10447713457676206225u, 9150747060186627967u, 281629680514649643u, 16292379802327414201u, 4246732448623781667u, 16094474695182830269u, 8062815290495565607u, 6579730370240349621u, 2263404180823257867u, 10162278172342986519u, 9809829218388894501u, 17107036403551874683u, 3770881385233444253u, 2124755861893246783u, 8124213711219232577u, 14513935692512591373u, 2780916192016515319u, 13900627050804827995u, 7527595115280579359u, 1950316554048586955u, 2094390156840385773u, 7204522363551799129u, 7255204782128442895u, 17298606475760824337u, 2939720171109091891u, 18374966859414961921u, 15430736487513693367u, 10354863773718001093u, 15383631589145234927u, 17181443938689762877u, 14245350405676059433u, 5149444458738708755u, 2707201348701401773u, 17305088903023944187u, 9134400602415662215u, 6365010734698503433u, 17050145153302519317u, 3455281367280943203u, 9196002980365592497u, 9941040754419844819u, 15751088062938241781u, 8779186981255537313u };
+    constexpr std::uint64_t TrialDivisionLimit[64] = { 970881267037344821u, 802032351030850070u, 636094623231363848u, 595056260442243600u, 498560650640798692u, 449920587163647600u, 428994048225803525u, 392483916461905353u, 348051774975651917u, 312656679215416129u, 302405640552615600u, 275324538413575397u, 259813296812810586u, 252695124297391118u, 233503089540627235u, 222249928598910260u, 207266787345051141u, 190172619316593315u, 182641030432767837u, 179094602657374287u, 172399477324388332u, 169236184162472950u, 163245522776190722u, 145249953336295682u, 140814840257324821u, 134647766961383588u, 132710389019493177u, 123803651501406386u, 122163868037811600u, 117495185182863386u, 113170209041162893u, 110459545351554201u, 106628578460748853u, 103054436165975148u, 101915713114417412u, 96579811904238490u, 95578984837873324u, 93638294790403815u, 92697206400550510u, 87425327363552377u, 82720825442643729u, 81263189752024456u, 80553467570784068u, 79170575423646144u, 77183029597111094u, 76542506529915151u, 73493004277727297u, 71777214294589695u, 70139711306880424u, 68575256779589411u, 68069166323651481u, 66594743948409933u, 65646776063023315u, 65182841249857072u, 62958170900032599u, 60087114246610917u, 59314289626075728u, 58935284580541698u, 58191621683626345u, 55730344633563600u, 54738112978366622u, 53160645745560667u, 52856000211202153u, 52257065364616293u };
+    // n must be larger than 353. The primes are checked in groups of 16 without branches, because most factors are found in the first group.
+    LIBCPPRIME_CONSTEXPR bool HasMediumFactorScalar(const std::uint64_t n) noexcept {
+        for (std::int32_t i = 0; i != 64; i += 16) {
+            bool found = false;
+            for (std::int32_t j = i; j != i + 16; ++j) found |= n * TrialDivisionInverse[j] <= TrialDivisionLimit[j];
+            if (found) return true;
+        }
+        return false;
+    }
+    // Bits is an upper bound on the bit width of x, which lets the comparisons against larger thresholds be folded away.
+    template<std::int32_t Bits = 32> LIBCPPRIME_CONSTEXPR bool IsPrime32(const std::uint32_t x) noexcept {
         if (x < 85849) {
+            LIBCPPRIME_STATS_TIER(Gcd32);
             const std::uint32_t a = static_cast<std::uint32_t>(Divu128(272518712866683587ull % x, 10755835586592736005ull, x).low);
-            if (a == 0) return false;
+            if (a == 0) {
+                LIBCPPRIME_STATS_ADD(gcd_exits, 1);
+                return false;
+            }
             if (x < 11881) return GCD(a, x) == 1;
             const std::uint32_t b = static_cast<std::uint32_t>(Divu128(827936745744686818ull % x, 10132550402535125089ull, x).low);
-            if (b == 0) return false;
+            if (b == 0) {
+                LIBCPPRIME_STATS_ADD(gcd_exits, 1);
+                return false;
+            }
             if (x < 39601) return GCD((a * b) % x, x) == 1;
             const std::uint32_t c = static_cast<std::uint32_t>(Divu128(9647383993136055606ull % x, 17068348107132031867ull, x).low * a * b % x);
-            if (c == 0) return false;
+            if (c == 0) {
+                LIBCPPRIME_STATS_ADD(gcd_exits, 1);
+                return false;
+            }
             return GCD(c, x) == 1;
         }
         const std::uint32_t h = x * 0xad625b89;
@@ -394,7 +557,9 @@ namespace internal {
         std::uint32_t pw = static_cast<std::uint32_t>(Bases[h >> 24]);
         std::uint32_t s = CountrZero(d);
         d >>= s;
-        if (x < (1u << 21)) {
+        LIBCPPRIME_STATS_ADD(squarings, 63 - CountlZero(d));
+        if (Bits <= 21 || x < (1u << 21)) {
+            LIBCPPRIME_STATS_TIER(Barrett32);
             std::uint64_t m = 0xffffffffffffffff / x + 1;
             auto mul = [m, x](std::uint32_t a, std::uint32_t b) -> std::uint32_t {
                 return static_cast<std::uint32_t>(Mulu128High(static_cast<std::uint64_t>(a) * b * m, x));
@@ -414,12 +579,18 @@ namespace internal {
             bool flag = cur == 1 || cur == x - 1;
             if (x % 4 == 3) return flag;
             if (flag) return true;
+            // The squarings are counted at the exits, from the original s = CountrZero(x - 1).
             while (--s) {
                 cur = mul(cur, cur);
-                if (cur == x - 1) return true;
+                if (cur == x - 1) {
+                    LIBCPPRIME_STATS_ADD(squarings, CountrZero(x - 1) - s);
+                    return true;
+                }
             }
+            LIBCPPRIME_STATS_ADD(squarings, CountrZero(x - 1) - 1);
             return false;
         } else {
+            LIBCPPRIME_STATS_TIER(Modulo32);
             std::uint32_t cur = pw;
             if (d != 1) {
                 pw = std::uint64_t(pw) * pw % x;
@@ -437,8 +608,12 @@ namespace internal {
             if (flag) return true;
             while (--s) {
                 cur = std::uint64_t(cur) * cur % x;
-                if (cur == x - 1) return true;
+                if (cur == x - 1) {
+                    LIBCPPRIME_STATS_ADD(squarings, CountrZero(x - 1) - s);
+                    return true;
+                }
             }
+            LIBCPPRIME_STATS_ADD(squarings, CountrZero(x - 1) - 1);
             return false;
         }
     }
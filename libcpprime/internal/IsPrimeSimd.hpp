@@ -0,0 +1,364 @@
+/**
+ * libcpprime internal/IsPrimeSimd.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+**/
+
+#include "./IsPrimeCommon.hpp"
+
+#ifndef LIBCPPRIME_INCLUDED_IS_PRIME_SIMD
+#define LIBCPPRIME_INCLUDED_IS_PRIME_SIMD
+
+#if !defined(LIBCPPRIME_NO_SIMD) && defined(__x86_64__) && ((defined(__clang__) && __clang_major__ >= 6) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8))
+#define LIBCPPRIME_SIMD
+#include <immintrin.h>
+#define LIBCPPRIME_TARGET(features) __attribute__((target(features)))
+#define LIBCPPRIME_TARGET_INLINE(features) __attribute__((target(features), always_inline)) inline
+#endif
+
+#if defined(LIBCPPRIME_SIMD) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace cppr {
+
+namespace internal {
+
+    enum class SimdLevel : std::int32_t { Scalar, AVX2, AVX512, AVX512IFMA };
+
+#ifdef LIBCPPRIME_SIMD
+    inline SimdLevel DetectSimdLevel() noexcept {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) return __builtin_cpu_supports("avx512ifma") ? SimdLevel::AVX512IFMA : SimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        return SimdLevel::Scalar;
+    }
+    inline SimdLevel GetSimdLevel() noexcept {
+        static const SimdLevel level = DetectSimdLevel();
+        return level;
+    }
+
+    LIBCPPRIME_TARGET_INLINE("avx512f") __m512i SelectDigitAvx512(const __m512i D, const std::int32_t pos, const __m512i* table) noexcept {
+        const __m512i digit = _mm512_srl_epi64(D, _mm_cvtsi32_si128(pos));
+        const __mmask8 m0 = _mm512_test_epi64_mask(digit, _mm512_set1_epi64(1)), m1 = _mm512_test_epi64_mask(digit, _mm512_set1_epi64(2));
+        return _mm512_mask_blend_epi64(m1, _mm512_mask_blend_epi64(m0, table[0], table[1]), _mm512_mask_blend_epi64(m0, table[2], table[3]));
+    }
+    // Montgomery multiplication with R = 2^52, which needs mod < 2^52 and a, b < mod.
+    LIBCPPRIME_TARGET_INLINE("avx512f,avx512ifma") __m512i MontgomeryMulIfma(const __m512i a, const __m512i b, const __m512i mod, const __m512i nr) noexcept {
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i low = _mm512_madd52lo_epu64(zero, a, b), high = _mm512_madd52hi_epu64(zero, a, b);
+        const __m512i q = _mm512_madd52lo_epu64(zero, low, nr);
+        const __m512i carry = _mm512_srli_epi64(_mm512_madd52lo_epu64(low, q, mod), 52);
+        const __m512i t = _mm512_add_epi64(_mm512_madd52hi_epu64(high, q, mod), carry);
+        return _mm512_min_epu64(t, _mm512_sub_epi64(t, mod));
+    }
+    // Same algorithm as MillerRabinInterleaved with one modulus per 64-bit lane.
+    template<std::int32_t K> LIBCPPRIME_TARGET("avx512f,avx512ifma") std::uint32_t MillerRabinIfma(const std::uint64_t* x, const std::uint64_t (*bases)[K]) noexcept {
+        alignas(64) std::uint64_t nr[8], one[8], mone[8], rs[8], D[8], S[8], raw[K][8];
+        std::int32_t max_bits = 0, max_S = 0;
+        for (std::int32_t l = 0; l != 8; ++l) {
+            const std::int32_t s = CountrZero(x[l] - 1);
+            S[l] = static_cast<std::uint64_t>(s);
+            D[l] = (x[l] - 1) >> s;
+            const std::int32_t bits = 64 - CountlZero(D[l]);
+            max_bits = max_bits < bits ? bits : max_bits;
+            max_S = max_S < s ? s : max_S;
+            std::uint64_t inv = x[l];
+            for (std::uint32_t i = 0; i != 5; ++i) inv *= 2 - x[l] * inv;
+            nr[l] = (0 - inv) & ((1ull << 52) - 1);
+            one[l] = (1ull << 52) % x[l];
+            mone[l] = x[l] - one[l];
+            const Int64Pair sq = Mulu128(one[l], one[l]);
+            rs[l] = Divu128(sq.high, sq.low, x[l]).low;
+            for (std::int32_t k = 0; k != K; ++k) raw[k][l] = bases[l][k];
+        }
+        const __m512i mod = _mm512_loadu_si512(x), inv = _mm512_load_si512(nr), r2 = _mm512_load_si512(rs);
+        const __m512i vone = _mm512_load_si512(one), vmone = _mm512_load_si512(mone), vD = _mm512_load_si512(D), vS = _mm512_load_si512(S);
+        __m512i table[K][4], a[K];
+        for (std::int32_t k = 0; k != K; ++k) {
+            const __m512i b = MontgomeryMulIfma(_mm512_load_si512(raw[k]), r2, mod, inv);
+            table[k][0] = vone, table[k][1] = b;
+            table[k][2] = MontgomeryMulIfma(b, b, mod, inv);
+            table[k][3] = MontgomeryMulIfma(table[k][2], b, mod, inv);
+        }
+        std::int32_t pos = (max_bits + 1) / 2 * 2 - 2;
+        for (std::int32_t k = 0; k != K; ++k) a[k] = SelectDigitAvx512(vD, pos, table[k]);
+        while (pos != 0) {
+            pos -= 2;
+            for (std::int32_t k = 0; k != K; ++k) {
+                a[k] = MontgomeryMulIfma(a[k], a[k], mod, inv);
+                a[k] = MontgomeryMulIfma(a[k], a[k], mod, inv);
+                a[k] = MontgomeryMulIfma(a[k], SelectDigitAvx512(vD, pos, table[k]), mod, inv);
+            }
+        }
+        __mmask8 ok[K], all = 0xff;
+        for (std::int32_t k = 0; k != K; ++k) {
+            ok[k] = _mm512_cmpeq_epu64_mask(a[k], vone) | _mm512_cmpeq_epu64_mask(a[k], vmone);
+            all &= ok[k];
+        }
+        for (std::int32_t i = 1; i < max_S && all != 0xff; ++i) {
+            const __mmask8 active = _mm512_cmpgt_epu64_mask(vS, _mm512_set1_epi64(i));
+            all = 0xff;
+            for (std::int32_t k = 0; k != K; ++k) {
+                a[k] = MontgomeryMulIfma(a[k], a[k], mod, inv);
+                ok[k] |= _mm512_mask_cmpeq_epu64_mask(active, a[k], vmone);
+                all &= ok[k];
+            }
+        }
+        return all;
+    }
+#endif
+
+    // Runs the strong probable prime test of 8 odd moduli above 2^32 with K bases each on the vector unit.
+    // It returns false without touching res when no kernel applies, and the caller falls back to MillerRabinInterleaved.
+    // Splitting 64-bit products into 32x32 partial products on AVX2 or AVX-512F was measured to be slower than the scalar ladder,
+    // so only the IFMA kernel, which needs every modulus to be below 2^52, is used.
+    template<std::int32_t K> bool MillerRabinSimd(const std::uint64_t* x, const std::uint64_t (*bases)[K], bool* res) noexcept {
+#ifdef LIBCPPRIME_SIMD
+        std::uint64_t top = 0;
+        for (std::int32_t l = 0; l != 8; ++l) top |= x[l];
+        if (top >= (1ull << 52) || GetSimdLevel() != SimdLevel::AVX512IFMA) return false;
+        const std::uint32_t mask = MillerRabinIfma<K>(x, bases);
+        for (std::int32_t l = 0; l != 8; ++l) res[l] = (mask >> l) & 1;
+        return true;
+#else
+        static_cast<void>(x), static_cast<void>(bases), static_cast<void>(res);
+        return false;
+#endif
+    }
+
+    template<std::int32_t K> LIBCPPRIME_CONSTEXPR void MillerRabin8(const std::uint64_t* x, const std::uint64_t (*bases)[K], bool* res) noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+        if (!std::is_constant_evaluated())
+#endif
+            if (MillerRabinSimd<K>(x, bases, res)) return;
+        MillerRabinInterleaved<4, K>(x, bases, res);
+        MillerRabinInterleaved<4, K>(x + 4, bases + 4, res + 4);
+    }
+
+#ifdef LIBCPPRIME_SIMD
+    // Montgomery multiplication with R = 2^32 of the values in the low halves of the 64-bit lanes, which needs a, b < mod < 2^32.
+    // m * mod agrees with a * b in the low 32 bits, so the high halves can be subtracted and the result is in (-mod, mod) before the correction.
+    LIBCPPRIME_TARGET_INLINE("avx2") __m256i MontgomeryMul32Avx2(const __m256i a, const __m256i b, const __m256i mod, const __m256i inv) noexcept {
+        const __m256i t = _mm256_mul_epu32(a, b);
+        const __m256i m = _mm256_mul_epu32(t, inv);
+        const __m256i d = _mm256_sub_epi64(_mm256_srli_epi64(t, 32), _mm256_srli_epi64(_mm256_mul_epu32(m, mod), 32));
+        return _mm256_add_epi64(d, _mm256_and_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), d), mod));
+    }
+    LIBCPPRIME_TARGET_INLINE("avx512f") __m512i MontgomeryMul32Avx512(const __m512i a, const __m512i b, const __m512i mod, const __m512i inv) noexcept {
+        const __m512i t = _mm512_mul_epu32(a, b);
+        const __m512i m = _mm512_mul_epu32(t, inv);
+        const __m512i d = _mm512_sub_epi64(_mm512_srli_epi64(t, 32), _mm512_srli_epi64(_mm512_mul_epu32(m, mod), 32));
+        return _mm512_min_epu64(d, _mm512_add_epi64(d, mod));
+    }
+    LIBCPPRIME_TARGET_INLINE("avx2") __m256i SelectDigitAvx2(const __m256i D, const std::int32_t pos, const __m256i* table) noexcept {
+        const __m256i digit = _mm256_srl_epi64(D, _mm_cvtsi32_si128(pos));
+        // blendv_pd picks by the sign bit, so the two bits of the digit are moved there.
+        const __m256d m0 = _mm256_castsi256_pd(_mm256_slli_epi64(digit, 63)), m1 = _mm256_castsi256_pd(_mm256_slli_epi64(digit, 62));
+        const __m256d low = _mm256_blendv_pd(_mm256_castsi256_pd(table[0]), _mm256_castsi256_pd(table[1]), m0);
+        const __m256d high = _mm256_blendv_pd(_mm256_castsi256_pd(table[2]), _mm256_castsi256_pd(table[3]), m0);
+        return _mm256_castpd_si256(_mm256_blendv_pd(low, high, m1));
+    }
+    // Returns a mod n for a < 2^48 and 2^16 < n < 2^32. The quotient from the double division is off by at most one, and a hardware division costs more than the whole ladder of a lane.
+    inline std::uint64_t Mod48(const std::uint64_t a, const std::uint32_t n) noexcept {
+        const std::uint64_t q = static_cast<std::uint64_t>(static_cast<double>(a) / static_cast<double>(n));
+        const std::int64_t r = static_cast<std::int64_t>(a - q * n);
+        return static_cast<std::uint64_t>(r < 0 ? r + n : r >= static_cast<std::int64_t>(n) ? r - n : r);
+    }
+    // The per-lane constants of the 32-bit kernels: x^-1 mod 2^32, R mod x, -R mod x and base * R mod x.
+    template<std::int32_t N> struct MillerRabin32Lanes {
+        alignas(64) std::uint64_t x[N], inv[N], one[N], mone[N], base[N], D[N], S[N];
+        std::int32_t max_bits = 0, max_S = 0;
+        void init(const std::uint32_t* in, const std::uint32_t* bases) noexcept {
+            for (std::int32_t l = 0; l != N; ++l) {
+                const std::uint32_t n = in[l];
+                const std::int32_t s = CountrZero(n - 1);
+                std::uint32_t r = n;
+                for (std::int32_t i = 0; i != 4; ++i) r *= 2 - n * r;
+                x[l] = n, inv[l] = r, S[l] = static_cast<std::uint64_t>(s), D[l] = (n - 1) >> s;
+                one[l] = Mod48(1ull << 32, n), mone[l] = n - one[l];
+                base[l] = Mod48(static_cast<std::uint64_t>(bases[l]) << 32, n);
+                const std::int32_t bits = 64 - CountlZero(D[l]);
+                max_bits = max_bits < bits ? bits : max_bits;
+                max_S = max_S < s ? s : max_S;
+            }
+        }
+    };
+    // The same ladder as MillerRabinIfma for 4 * V odd moduli from 2^16 to 2^32 with one base each. A Montgomery multiplication is three dependent multiplications,
+    // so V vectors are processed together to keep the multipliers busy.
+    template<std::int32_t V> LIBCPPRIME_TARGET("avx2") std::uint32_t MillerRabin32Avx2(const std::uint32_t* in, const std::uint32_t* bases) noexcept {
+        constexpr std::uint32_t Full = (1ull << (4 * V)) - 1;
+        MillerRabin32Lanes<4 * V> c;
+        c.init(in, bases);
+        __m256i mod[V], inv[V], one[V], mone[V], D[V], S[V], table[V][4], a[V], ok[V];
+        for (std::int32_t v = 0; v != V; ++v) {
+            mod[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(c.x + 4 * v)), inv[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(c.inv + 4 * v));
+            one[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(c.one + 4 * v)), mone[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(c.mone + 4 * v));
+            D[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(c.D + 4 * v)), S[v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(c.S + 4 * v));
+            table[v][0] = one[v], table[v][1] = _mm256_load_si256(reinterpret_cast<const __m256i*>(c.base + 4 * v));
+            table[v][2] = MontgomeryMul32Avx2(table[v][1], table[v][1], mod[v], inv[v]);
+            table[v][3] = MontgomeryMul32Avx2(table[v][2], table[v][1], mod[v], inv[v]);
+        }
+        std::int32_t pos = (c.max_bits + 1) / 2 * 2 - 2;
+        for (std::int32_t v = 0; v != V; ++v) a[v] = SelectDigitAvx2(D[v], pos, table[v]);
+        while (pos != 0) {
+            pos -= 2;
+            for (std::int32_t v = 0; v != V; ++v) {
+                a[v] = MontgomeryMul32Avx2(a[v], a[v], mod[v], inv[v]);
+                a[v] = MontgomeryMul32Avx2(a[v], a[v], mod[v], inv[v]);
+                a[v] = MontgomeryMul32Avx2(a[v], SelectDigitAvx2(D[v], pos, table[v]), mod[v], inv[v]);
+            }
+        }
+        std::uint32_t all = 0;
+        for (std::int32_t v = 0; v != V; ++v) {
+            ok[v] = _mm256_or_si256(_mm256_cmpeq_epi64(a[v], one[v]), _mm256_cmpeq_epi64(a[v], mone[v]));
+            all |= static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(ok[v]))) << (4 * v);
+        }
+        for (std::int32_t i = 1; i < c.max_S && all != Full; ++i) {
+            all = 0;
+            for (std::int32_t v = 0; v != V; ++v) {
+                a[v] = MontgomeryMul32Avx2(a[v], a[v], mod[v], inv[v]);
+                const __m256i active = _mm256_cmpgt_epi64(S[v], _mm256_set1_epi64x(i));
+                ok[v] = _mm256_or_si256(ok[v], _mm256_and_si256(active, _mm256_cmpeq_epi64(a[v], mone[v])));
+                all |= static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(ok[v]))) << (4 * v);
+            }
+        }
+        return all;
+    }
+    // The AVX-512 version of MillerRabin32Avx2 for 8 * V moduli.
+    template<std::int32_t V> LIBCPPRIME_TARGET("avx512f") std::uint32_t MillerRabin32Avx512(const std::uint32_t* in, const std::uint32_t* bases) noexcept {
+        constexpr std::uint32_t Full = (1ull << (8 * V)) - 1;
+        MillerRabin32Lanes<8 * V> c;
+        c.init(in, bases);
+        __m512i mod[V], inv[V], one[V], mone[V], D[V], S[V], table[V][4], a[V];
+        __mmask8 ok[V];
+        for (std::int32_t v = 0; v != V; ++v) {
+            mod[v] = _mm512_load_si512(c.x + 8 * v), inv[v] = _mm512_load_si512(c.inv + 8 * v);
+            one[v] = _mm512_load_si512(c.one + 8 * v), mone[v] = _mm512_load_si512(c.mone + 8 * v);
+            D[v] = _mm512_load_si512(c.D + 8 * v), S[v] = _mm512_load_si512(c.S + 8 * v);
+            table[v][0] = one[v], table[v][1] = _mm512_load_si512(c.base + 8 * v);
+            table[v][2] = MontgomeryMul32Avx512(table[v][1], table[v][1], mod[v], inv[v]);
+            table[v][3] = MontgomeryMul32Avx512(table[v][2], table[v][1], mod[v], inv[v]);
+        }
+        std::int32_t pos = (c.max_bits + 1) / 2 * 2 - 2;
+        for (std::int32_t v = 0; v != V; ++v) a[v] = SelectDigitAvx512(D[v], pos, table[v]);
+        while (pos != 0) {
+            pos -= 2;
+            for (std::int32_t v = 0; v != V; ++v) {
+                a[v] = MontgomeryMul32Avx512(a[v], a[v], mod[v], inv[v]);
+                a[v] = MontgomeryMul32Avx512(a[v], a[v], mod[v], inv[v]);
+                a[v] = MontgomeryMul32Avx512(a[v], SelectDigitAvx512(D[v], pos, table[v]), mod[v], inv[v]);
+            }
+        }
+        std::uint32_t all = 0;
+        for (std::int32_t v = 0; v != V; ++v) {
+            ok[v] = _mm512_cmpeq_epu64_mask(a[v], one[v]) | _mm512_cmpeq_epu64_mask(a[v], mone[v]);
+            all |= static_cast<std::uint32_t>(ok[v]) << (8 * v);
+        }
+        for (std::int32_t i = 1; i < c.max_S && all != Full; ++i) {
+            all = 0;
+            for (std::int32_t v = 0; v != V; ++v) {
+                a[v] = MontgomeryMul32Avx512(a[v], a[v], mod[v], inv[v]);
+                ok[v] |= _mm512_mask_cmpeq_epu64_mask(_mm512_cmpgt_epu64_mask(S[v], _mm512_set1_epi64(i)), a[v], mone[v]);
+                all |= static_cast<std::uint32_t>(ok[v]) << (8 * v);
+            }
+        }
+        return all;
+    }
+#endif
+
+    // Runs the strong probable prime test of 32 odd moduli from 2^16 to 2^32 to one base each, and falls back to IsPrime32 when no kernel applies.
+    // 32 moduli make 8 vectors on AVX2 and 4 on AVX-512, which was the smallest group that hides the latency of the multiplications.
+    LIBCPPRIME_CONSTEXPR void MillerRabin32x32(const std::uint32_t* x, const std::uint32_t* bases, bool* res) noexcept {
+#ifdef LIBCPPRIME_SIMD
+#ifdef __cpp_lib_is_constant_evaluated
+        if (!std::is_constant_evaluated())
+#endif
+        {
+            const SimdLevel level = GetSimdLevel();
+            if (level != SimdLevel::Scalar) {
+                const std::uint32_t mask = level >= SimdLevel::AVX512 ? MillerRabin32Avx512<4>(x, bases) : MillerRabin32Avx2<8>(x, bases);
+                for (std::int32_t l = 0; l != 32; ++l) res[l] = (mask >> l) & 1;
+                return;
+            }
+        }
+#endif
+        static_cast<void>(bases);
+        for (std::int32_t l = 0; l != 32; ++l) res[l] = IsPrime32(x[l]);
+    }
+
+#ifdef LIBCPPRIME_SIMD
+    // AVX2 has no 64-bit multiplication, so the low half of n * inverse is assembled from three 32x32 products.
+    LIBCPPRIME_TARGET("avx2") inline bool HasMediumFactorAvx2(const std::uint64_t n) noexcept {
+        const __m256i lo = _mm256_set1_epi64x(static_cast<long long>(n & 0xffffffff)), hi = _mm256_set1_epi64x(static_cast<long long>(n >> 32));
+        const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+        for (std::int32_t i = 0; i != 64; i += 16) {
+            __m256i found = _mm256_setzero_si256();
+            for (std::int32_t j = i; j != i + 16; j += 4) {
+                const __m256i inv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(TrialDivisionInverse + j)), limit = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(TrialDivisionLimit + j));
+                const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(lo, _mm256_srli_epi64(inv, 32)), _mm256_mul_epu32(hi, inv));
+                const __m256i prod = _mm256_add_epi64(_mm256_mul_epu32(lo, inv), _mm256_slli_epi64(cross, 32));
+                // prod <= limit as unsigned integers
+                found = _mm256_or_si256(found, _mm256_or_si256(_mm256_cmpgt_epi64(_mm256_xor_si256(limit, sign), _mm256_xor_si256(prod, sign)), _mm256_cmpeq_epi64(limit, prod)));
+            }
+            if (!_mm256_testz_si256(found, found)) return true;
+        }
+        return false;
+    }
+    LIBCPPRIME_TARGET("avx512f,avx512dq") inline bool HasMediumFactorAvx512(const std::uint64_t n) noexcept {
+        const __m512i vn = _mm512_set1_epi64(static_cast<long long>(n));
+        for (std::int32_t i = 0; i != 64; i += 32) {
+            __mmask8 found = 0;
+            for (std::int32_t j = i; j != i + 32; j += 8) found |= _mm512_cmple_epu64_mask(_mm512_mullo_epi64(vn, _mm512_loadu_si512(TrialDivisionInverse + j)), _mm512_loadu_si512(TrialDivisionLimit + j));
+            if (found != 0) return true;
+        }
+        return false;
+    }
+#endif
+
+    // Returns true if n has a prime factor from 19 to 353. n must be larger than 353.
+    LIBCPPRIME_CONSTEXPR bool HasMediumFactor(const std::uint64_t n) noexcept {
+#ifdef LIBCPPRIME_SIMD
+#ifdef __cpp_lib_is_constant_evaluated
+        if (!std::is_constant_evaluated())
+#endif
+        {
+            const SimdLevel level = GetSimdLevel();
+            if (level >= SimdLevel::AVX512) return HasMediumFactorAvx512(n);
+            if (level == SimdLevel::AVX2) return HasMediumFactorAvx2(n);
+        }
+#endif
+        return HasMediumFactorScalar(n);
+    }
+
+}  // namespace internal
+
+}  // namespace cppr
+
+#if defined(LIBCPPRIME_SIMD) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
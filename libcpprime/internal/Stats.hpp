@@ -0,0 +1,178 @@
+/**
+ * libcpprime internal/Stats.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#ifndef LIBCPPRIME_INCLUDED_STATS
+#define LIBCPPRIME_INCLUDED_STATS
+
+#include <cstdint>
+#ifdef __has_include
+#if __has_include(<type_traits>)
+#include <type_traits>
+#endif
+#endif
+#ifdef LIBCPPRIME_STATS_LATENCY
+#ifndef LIBCPPRIME_STATS
+#define LIBCPPRIME_STATS
+#endif
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+namespace cppr {
+
+// Counters of the primality tests run by one thread, which are only collected when LIBCPPRIME_STATS is defined.
+struct PrimalityStats {
+    // The paths that a test can end in. Every call to a tier function counts once, including the calls made by NextPrime and the other helpers.
+    enum Tier : std::int32_t {
+        Table16,             // IsPrime16, the bit table below 2^16
+        Table10,             // IsPrime10, the bit table below 1024 used by IsPrimeNoTable
+        Gcd32,               // IsPrime32 below 85849, a product of residues and one GCD
+        Barrett32,           // IsPrime32 below 2^21, one Miller-Rabin base with the Barrett reduction
+        Modulo32,            // IsPrime32 from 2^21, one Miller-Rabin base with 64-bit division
+        TwoBases64,          // IsPrime64 below 2^49 (test2)
+        ThreeBases64,        // IsPrime64 from 2^49 (test3)
+        Batch32,             // inputs of IsPrimeBatch from 85849 to 2^32 tested in groups of 32, while the rest of a batch goes through IsPrime32
+        Batch64,             // 64-bit inputs of IsPrimeBatch tested in groups of 8, while the rest of a batch goes through IsPrime64
+        MillerRabinNoTable,  // IsPrime64MillerRabin below 2^62
+        BailliePSW,          // IsPrime64BailliePSW, counted before the base 2 test
+        Lucas,               // the Lucas stage of IsPrime64BailliePSW, reached by the inputs that passed base 2
+        TierCount
+    };
+    // The entry points whose latency is recorded when LIBCPPRIME_STATS_LATENCY is defined.
+    enum Entry : std::int32_t { IsPrimeEntry, IsPrimeNoTableEntry, EntryCount };
+
+    std::uint64_t tiers[TierCount] = {};
+    std::uint64_t small_factor_exits = 0;    // inputs rejected by the divisibility check by 2, 3, 5, 7, 11, 13 and 17 before any tier
+    std::uint64_t trial_division_exits = 0;  // inputs rejected by the trial division by the primes from 19 to 353
+    std::uint64_t gcd_exits = 0;             // inputs of Gcd32 rejected by a zero residue before the GCD
+    std::uint64_t squarings = 0;             // iterations of the squaring loops, one per bit of each exponent and one per extra step, per base
+    // latency[e][b] counts the calls to entry e that took between 2^(b-1) and 2^b - 1 cycles, or nanoseconds off x86.
+    std::uint64_t latency[EntryCount][64] = {};
+
+    PrimalityStats& merge(const PrimalityStats& other) noexcept {
+        for (std::int32_t i = 0; i != TierCount; ++i) tiers[i] += other.tiers[i];
+        small_factor_exits += other.small_factor_exits;
+        trial_division_exits += other.trial_division_exits;
+        gcd_exits += other.gcd_exits;
+        squarings += other.squarings;
+        for (std::int32_t e = 0; e != EntryCount; ++e)
+            for (std::int32_t b = 0; b != 64; ++b) latency[e][b] += other.latency[e][b];
+        return *this;
+    }
+    PrimalityStats& operator+=(const PrimalityStats& other) noexcept {
+        return merge(other);
+    }
+    std::uint64_t calls() const noexcept {
+        std::uint64_t res = small_factor_exits + trial_division_exits;
+        for (std::int32_t i = 0; i != TierCount; ++i) res += i == Lucas ? 0 : tiers[i];
+        return res;
+    }
+};
+
+#ifdef LIBCPPRIME_STATS
+
+namespace internal {
+
+    inline PrimalityStats& LocalStats() noexcept {
+        static thread_local PrimalityStats stats;
+        return stats;
+    }
+
+#ifdef LIBCPPRIME_STATS_LATENCY
+    inline std::uint64_t StatsClock() noexcept {
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+    inline void RecordLatency(const PrimalityStats::Entry entry, const std::uint64_t elapsed) noexcept {
+        std::int32_t b = 0;
+        while (b != 63 && (elapsed >> b) != 0) ++b;
+        ++LocalStats().latency[entry][b];
+    }
+#endif
+
+}  // namespace internal
+
+#endif
+
+// Returns a copy of the counters of the calling thread, which are all zero unless LIBCPPRIME_STATS is defined.
+// The counters of several threads can be combined with merge.
+inline PrimalityStats ThreadStats() noexcept {
+#ifdef LIBCPPRIME_STATS
+    return internal::LocalStats();
+#else
+    return PrimalityStats();
+#endif
+}
+
+inline void ResetThreadStats() noexcept {
+#ifdef LIBCPPRIME_STATS
+    internal::LocalStats() = PrimalityStats();
+#endif
+}
+
+}  // namespace cppr
+
+// The hooks placed on the hot paths. They expand to nothing unless LIBCPPRIME_STATS is defined, and are skipped during constant evaluation.
+#ifdef LIBCPPRIME_STATS
+#ifdef __cpp_lib_is_constant_evaluated
+#define LIBCPPRIME_STATS_RUNTIME (!std::is_constant_evaluated())
+#else
+#define LIBCPPRIME_STATS_RUNTIME true
+#endif
+#define LIBCPPRIME_STATS_ADD(field, n) \
+    do { \
+        if (LIBCPPRIME_STATS_RUNTIME) ::cppr::internal::LocalStats().field += (n); \
+    } while (false)
+#else
+#define LIBCPPRIME_STATS_ADD(field, n) static_cast<void>(0)
+#endif
+#define LIBCPPRIME_STATS_TIER(tier) LIBCPPRIME_STATS_ADD(tiers[::cppr::PrimalityStats::tier], 1)
+// Returns the value of expr from the enclosing function, timing it when LIBCPPRIME_STATS_LATENCY is defined.
+#ifdef LIBCPPRIME_STATS_LATENCY
+#define LIBCPPRIME_STATS_TIMED_RETURN(entry, expr) \
+    do { \
+        if (LIBCPPRIME_STATS_RUNTIME) { \
+            const std::uint64_t libcpprime_start = ::cppr::internal::StatsClock(); \
+            const bool libcpprime_res = (expr); \
+            ::cppr::internal::RecordLatency(::cppr::PrimalityStats::entry, ::cppr::internal::StatsClock() - libcpprime_start); \
+            return libcpprime_res; \
+        } \
+        return (expr); \
+    } while (false)
+#else
+#define LIBCPPRIME_STATS_TIMED_RETURN(entry, expr) return (expr)
+#endif
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * libcpprime internal/ThreadPool.hpp https://github.com/Rac75116/libcpprime
+ *
+ * MIT License
+ *
+ * Copyright (c) 2025 Rac75116
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+**/
+
+#ifndef LIBCPPRIME_INCLUDED_THREAD_POOL
+#define LIBCPPRIME_INCLUDED_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cppr {
+
+namespace internal {
+
+    // threads, or one per hardware thread if threads == 0.
+    inline std::size_t ThreadCount(const std::size_t threads) noexcept {
+        if (threads != 0) return threads;
+        const std::size_t hardware = std::thread::hardware_concurrency();
+        return hardware != 0 ? hardware : 1;
+    }
+
+    // A fixed set of threads that calls task(worker, i, end) for every i in [0, count).
+    // Each worker starts with a contiguous share of the indices and takes them from the front, and end is
+    // the end of its share at that time, so consecutive calls on one worker usually see consecutive indices.
+    // A worker that runs out steals the back half of the largest remaining share.
+    class WorkStealingPool {
+        struct Share {
+            std::atomic<std::uint64_t> range;  // end << 32 | begin
+            char padding[64 - sizeof(std::atomic<std::uint64_t>)];
+        };
+        std::size_t threads_;
+        std::unique_ptr<Share[]> shares_;
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable start_, done_;
+        std::uint64_t generation_ = 0;
+        std::size_t running_ = 0;
+        bool stop_ = false;
+        void (*task_)(void*, std::size_t, std::uint32_t, std::uint32_t) = nullptr;
+        void* context_ = nullptr;
+        static std::uint64_t Pack(const std::uint32_t begin, const std::uint32_t end) noexcept { return static_cast<std::uint64_t>(end) << 32 | begin; }
+        bool Pop(const std::size_t worker, std::uint32_t& index, std::uint32_t& end) noexcept {
+            std::atomic<std::uint64_t>& range = shares_[worker].range;
+            std::uint64_t current = range.load();
+            while (true) {
+                const std::uint32_t b = static_cast<std::uint32_t>(current), e = static_cast<std::uint32_t>(current >> 32);
+                if (b >= e) return false;
+                if (range.compare_exchange_weak(current, Pack(b + 1, e))) {
+                    index = b, end = e;
+                    return true;
+                }
+            }
+        }
+        bool Steal(const std::size_t worker, std::uint32_t& index, std::uint32_t& end) noexcept {
+            while (true) {
+                std::size_t victim = threads_;
+                std::uint64_t observed = 0;
+                std::uint32_t largest = 0;
+                for (std::size_t v = 0; v != threads_; ++v) {
+                    if (v == worker) continue;
+                    const std::uint64_t current = shares_[v].range.load();
+                    const std::uint32_t b = static_cast<std::uint32_t>(current), e = static_cast<std::uint32_t>(current >> 32);
+                    if (b < e && e - b > largest) victim = v, observed = current, largest = e - b;
+                }
+                if (victim == threads_) return false;
+                const std::uint32_t b = static_cast<std::uint32_t>(observed), e = static_cast<std::uint32_t>(observed >> 32), mid = b + (e - b) / 2;
+                if (shares_[victim].range.compare_exchange_strong(observed, Pack(b, mid))) {
+                    // Our own share is empty, so no other thief touches it until this store.
+                    shares_[worker].range.store(Pack(mid + 1, e));
+                    index = mid, end = e;
+                    return true;
+                }
+            }
+        }
+        void Work(const std::size_t worker) {
+            std::uint32_t index = 0, end = 0;
+            while (Pop(worker, index, end) || Steal(worker, index, end)) task_(context_, worker, index, end);
+        }
+        void Loop(const std::size_t worker) {
+            std::uint64_t seen = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                    if (stop_) return;
+                    seen = generation_;
+                }
+                Work(worker);
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--running_ == 0) done_.notify_all();
+            }
+        }
+    public:
+        // The calling thread counts as worker 0.
+        explicit WorkStealingPool(const std::size_t threads) : threads_(ThreadCount(threads)), shares_(new Share[threads_]) {
+            for (std::size_t i = 0; i != threads_; ++i) shares_[i].range.store(0);
+            workers_.reserve(threads_ - 1);
+            for (std::size_t i = 1; i != threads_; ++i) workers_.emplace_back(&WorkStealingPool::Loop, this, i);
+        }
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+        ~WorkStealingPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            start_.notify_all();
+            for (std::thread& t : workers_) t.join();
+        }
+        std::size_t size() const noexcept { return threads_; }
+        // Hands [0, count) out to the workers, which start right away. task must stay alive until Wait returns.
+        template<class F> void Start(const std::uint32_t count, F& task) {
+            context_ = &task;
+            task_ = [](void* context, std::size_t worker, std::uint32_t index, std::uint32_t end) { (*static_cast<F*>(context))(worker, index, end); };
+            for (std::size_t i = 0; i != threads_; ++i) shares_[i].range.store(Pack(static_cast<std::uint32_t>(count * i / threads_), static_cast<std::uint32_t>(count * (i + 1) / threads_)));
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++generation_, running_ = threads_ - 1;
+            start_.notify_all();
+        }
+        // Works on the share of worker 0 and what is left of the others, and returns once every index is done.
+        void Wait() {
+            Work(0);
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [&] { return running_ == 0; });
+        }
+        template<class F> void Run(const std::uint32_t count, F& task) {
+            Start(count, task);
+            Wait();
+        }
+    };
+
+}  // namespace internal
+
+}  // namespace cppr
+
+#endif
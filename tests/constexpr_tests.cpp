@@ -1,5 +1,11 @@
+#include <libcpprime/Factorize.hpp>
 #include <libcpprime/IsPrime.hpp>
+#include <libcpprime/IsPrime128.hpp>
+#include <libcpprime/IsPrimeCT.hpp>
+#include <libcpprime/IsPrimeHashed.hpp>
 #include <libcpprime/IsPrimeNoTable.hpp>
+#include <libcpprime/Montgomery.hpp>
+#include <libcpprime/NextPrime.hpp>
 
 #define _ARG16(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, ...) _15
 #define HAS_COMMA(...)                                                                    _ARG16(__VA_ARGS__, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0)
@@ -45,6 +51,30 @@ constexpr bool ConstexprTest = []() {
         flag &= !cppr::IsPrime(Composites[i]);
         flag &= !cppr::IsPrimeNoTable(Composites[i]);
     }
+    bool res[250] = {};
+    cppr::IsPrimeBatch(Primes, 250, res);
+    for (std::uint32_t i = 0; i != 250; ++i) flag &= res[i];
+    cppr::IsPrimeBatch(Composites, 250, res);
+    for (std::uint32_t i = 0; i != 250; ++i) flag &= !res[i];
+    for (std::uint32_t i = 0; i != 250; ++i) {
+        if (Primes[i] < (1ull << 62)) flag &= cppr::IsPrime<cppr::Range::U62>(Primes[i]);
+        if (Composites[i] < (1ull << 49)) flag &= !cppr::IsPrime<cppr::Range::U49>(Composites[i]);
+    }
+    for (std::uint32_t i = 0; i != 250; ++i) flag &= cppr::IsPrimeHashed<cppr::HashedBases32x16>(Primes[i] >> 32) == cppr::IsPrime(Primes[i] >> 32);
+    for (std::uint32_t i = 0; i != 50; ++i) flag &= cppr::IsPrimeCT(Primes[i]) && !cppr::IsPrimeCT(Composites[i]);
+    for (std::uint32_t i = 0; i != 250; ++i) flag &= cppr::NextPrime(Primes[i]) == Primes[i] && cppr::PrevPrime(Primes[i]) == Primes[i];
+    flag &= cppr::NextPrime(18446744073709551558u) == 0 && cppr::PrevPrime(18446744073709551615u) == 18446744073709551557u;
+    const cppr::FactorizeResult f = cppr::Factorize(18446744073709551615u);
+    const std::uint64_t factors[7] = { 3, 5, 17, 257, 641, 65537, 6700417 };
+    flag &= f.size() == 7;
+    for (std::uint32_t i = 0; i != 7; ++i) flag &= f[i].prime == factors[i] && f[i].exponent == 1;
+    const cppr::FactorizeResult g = cppr::Factorize(1000000007ull * 998244353ull);
+    flag &= g.size() == 2 && g[0].prime == 998244353 && g[1].prime == 1000000007;
+    constexpr cppr::StaticMontgomery64<998244353> mint;
+    flag &= mint.val(mint.pow(mint.build(3), 998244352)) == 1 && mint.val(mint.mul(mint.build(2), mint.inv(mint.build(2)))) == 1;
+#if defined(__SIZEOF_INT128__)
+    flag &= cppr::IsPrime((static_cast<unsigned __int128>(1) << 127) - 1) && !cppr::IsPrime(static_cast<unsigned __int128>(18446744073709551557u) * 18446744073709551557u);
+#endif
     return flag;
 }();
 static_assert(ConstexprTest);
@@ -0,0 +1,22 @@
+// Compiled twice into one program by CI, once with LIBCPPRIME_LINK_TEST_MAIN, to check that every public header can be included by several translation units.
+#include <libcpprime/Factorize.hpp>
+#include <libcpprime/IsPrime.hpp>
+#include <libcpprime/IsPrime128.hpp>
+#include <libcpprime/IsPrimeCT.hpp>
+#include <libcpprime/IsPrimeHashed.hpp>
+#include <libcpprime/IsPrimeNoTable.hpp>
+#include <libcpprime/Montgomery.hpp>
+#include <libcpprime/NextPrime.hpp>
+#include <libcpprime/NthPrime.hpp>
+#include <libcpprime/ParallelSieve.hpp>
+#include <libcpprime/PrimalityCache.hpp>
+#include <libcpprime/PrimeBitmap.hpp>
+#include <libcpprime/PrimePi.hpp>
+#include <libcpprime/PrimeSieve.hpp>
+#include <libcpprime/PrimeView.hpp>
+#include <libcpprime/RandomPrime.hpp>
+#ifdef LIBCPPRIME_LINK_TEST_MAIN
+int main() {
+    return cppr::IsPrime(998244353) ? 0 : 1;
+}
+#endif
@@ -1,10 +1,309 @@
+#include <libcpprime/Factorize.hpp>
 #include <libcpprime/IsPrime.hpp>
+#include <libcpprime/IsPrime128.hpp>
+#include <libcpprime/IsPrimeCT.hpp>
+#include <libcpprime/IsPrimeHashed.hpp>
 #include <libcpprime/IsPrimeNoTable.hpp>
+#include <libcpprime/Montgomery.hpp>
+#include <libcpprime/NextPrime.hpp>
+#include <libcpprime/NthPrime.hpp>
+#include <libcpprime/ParallelSieve.hpp>
+#include <libcpprime/PrimalityCache.hpp>
+#include <libcpprime/PrimeBitmap.hpp>
+#include <libcpprime/PrimePi.hpp>
+#include <libcpprime/PrimeSieve.hpp>
+#include <libcpprime/PrimeView.hpp>
+#include <libcpprime/RandomPrime.hpp>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
 #include "tests/constexpr_tests.cpp"
+bool BatchTest(const std::vector<std::uint64_t>& v, bool expected) {
+    std::unique_ptr<bool[]> res(new bool[v.size() + 1]);
+    std::vector<std::uint8_t> mask(v.size() / 8 + 1);
+    cppr::IsPrimeBatch(v.data(), v.size(), res.get());
+    cppr::IsPrimeBatch(v.data(), v.size(), mask.data());
+    for (std::size_t i = 0; i != v.size(); ++i) {
+        if (res[i] != expected) return false;
+        if (static_cast<bool>(mask[i / 8] >> (i % 8) & 1) != expected) return false;
+    }
+    return true;
+}
+bool SieveTest(std::uint64_t lo, std::uint64_t hi, std::size_t segment_bytes = cppr::PrimeRange::DefaultSegmentBytes) {
+    std::vector<std::uint64_t> sieved;
+    cppr::ForEachPrime(lo, hi, [&](std::uint64_t p) { sieved.push_back(p); }, segment_bytes);
+    std::size_t i = 0;
+    for (std::uint64_t x = lo; x != hi; ++x) {
+        if (!cppr::IsPrime(x)) continue;
+        if (i == sieved.size() || sieved[i] != x) return false;
+        ++i;
+    }
+    return i == sieved.size();
+}
+bool ParallelSieveTest(std::uint64_t lo, std::uint64_t hi, std::size_t threads, std::size_t segment_bytes) {
+    std::vector<std::uint64_t> serial, parallel;
+    cppr::ForEachPrime(lo, hi, [&](std::uint64_t p) { serial.push_back(p); }, segment_bytes);
+    cppr::ForEachPrimeParallel(lo, hi, [&](std::uint64_t p) { parallel.push_back(p); }, threads, segment_bytes);
+    return serial == parallel && cppr::CountPrimes(lo, hi, threads, segment_bytes) == serial.size();
+}
+bool PrimeViewTest(std::uint64_t lo, std::uint64_t hi, std::size_t segment_bytes = cppr::PrimeRange::DefaultSegmentBytes) {
+    std::vector<std::uint64_t> sieved, lazy;
+    cppr::ForEachPrime(lo, hi, [&](std::uint64_t p) { sieved.push_back(p); }, segment_bytes);
+    cppr::PrimeView view = cppr::primes(lo, hi, segment_bytes);
+    for (const std::uint64_t p : view) lazy.push_back(p);
+    if (lazy != sieved) return false;
+    // A second pass over the same view starts over.
+    std::size_t n = 0;
+    for (const std::uint64_t p : view)
+        if (n == sieved.size() || sieved[n++] != p) return false;
+    if (n != sieved.size()) return false;
+#ifdef __cpp_lib_ranges
+    std::vector<std::uint64_t> taken;
+    for (const std::uint64_t p : cppr::primes(lo, hi, segment_bytes) | std::views::filter([](std::uint64_t p) { return p % 4 == 1; }) | std::views::take(100)) taken.push_back(p);
+    std::size_t i = 0;
+    for (const std::uint64_t p : sieved)
+        if (p % 4 == 1 && i != 100 && (i == taken.size() || taken[i++] != p)) return false;
+    if (i != taken.size()) return false;
+#endif
+    return true;
+}
+bool NextPrimeTest(std::uint64_t x) {
+    std::uint64_t next = x, prev = x;
+    while (!cppr::IsPrime(next) && next != 18446744073709551615u) ++next;
+    while (prev != 0 && !cppr::IsPrime(prev)) --prev;
+    return cppr::NextPrime(x) == (cppr::IsPrime(next) ? next : 0) && cppr::PrevPrime(x) == prev;
+}
+bool FactorizeTest(std::uint64_t n) {
+    const cppr::FactorizeResult res = cppr::Factorize(n);
+    if (n <= 1) return res.empty();
+    std::uint64_t last = 0;
+    for (const cppr::PrimePower& f : res) {
+        if (f.prime <= last || !cppr::IsPrime(f.prime) || f.exponent < 1) return false;
+        for (std::int32_t i = 0; i != f.exponent; ++i) {
+            if (n % f.prime != 0) return false;
+            n /= f.prime;
+        }
+        last = f.prime;
+    }
+    return n == 1;
+}
+bool PrimeBitmapTest(std::uint64_t bound) {
+    const char* path = "./tests/PrimeBitmap.bin";
+    if (!cppr::PrimeBitmap::Create(path, bound)) return false;
+    cppr::PrimeBitmap bitmap(path);
+    std::remove(path);
+    if (!bitmap.is_open() || bitmap.bound() != bound) return false;
+    for (std::uint64_t x = 0; x != bound + 1000; ++x)
+        if (bitmap.is_prime(x) != cppr::IsPrime(x)) return false;
+    const cppr::PrimeBitmap moved(static_cast<cppr::PrimeBitmap&&>(bitmap));
+    return !bitmap.is_open() && moved.bound() == bound && moved.is_prime(bound - 1) == cppr::IsPrime(bound - 1);
+}
+bool RangeTest(std::uint64_t x) {
+    const bool expected = cppr::IsPrime(x);
+    if (x < (1ull << 16) && (cppr::IsPrime<cppr::Range::U16>(x) != expected || cppr::IsPrimeBelow<1000>(x % 1000) != cppr::IsPrime(x % 1000))) return false;
+    if (x >= (1ull << 16) && (cppr::IsPrime<cppr::Range::U16>(x) || cppr::IsPrimeBelow<1000>(x))) return false;
+    if (x < (1ull << 32) && (cppr::IsPrime<cppr::Range::U32>(x) != expected || cppr::IsPrimeBelow<(1ull << 21)>(x % (1ull << 21)) != cppr::IsPrime(x % (1ull << 21)))) return false;
+    if (x < (1ull << 49) && cppr::IsPrime<cppr::Range::U49>(x) != expected) return false;
+    if (x < (1ull << 62) && (cppr::IsPrime<cppr::Range::U62>(x) != expected || cppr::IsPrimeBelow<1000000000000000000>(x % 1000000000000000000) != cppr::IsPrime(x % 1000000000000000000))) return false;
+    return cppr::IsPrime<cppr::Range::U64>(x) == expected;
+}
+bool TrialDivisionTest(std::uint64_t x) {
+    if (x <= 353) return true;
+    bool expected = false;
+    for (std::uint64_t p = 19; p <= 353; p += 2) expected |= x % p == 0 && cppr::IsPrime(p);
+    if (cppr::internal::HasMediumFactorScalar(x) != expected || cppr::internal::HasMediumFactor(x) != expected) return false;
+#ifdef LIBCPPRIME_SIMD
+    if (cppr::internal::GetSimdLevel() >= cppr::internal::SimdLevel::AVX2 && cppr::internal::HasMediumFactorAvx2(x) != expected) return false;
+#endif
+    return cppr::internal::IsPrimeBits<64, true>(x) == cppr::IsPrime(x);
+}
+bool HashedTest(std::uint64_t x) {
+    const bool expected = cppr::IsPrime(x);
+    return cppr::IsPrimeHashed<cppr::HashedBases32x256>(x) == expected && cppr::IsPrimeHashed<cppr::HashedBases32x16>(x) == expected;
+}
+template<class Rng> bool RandomPrimeTest(Rng& rng) {
+    for (std::int32_t bits = 2; bits <= 64; ++bits) {
+        for (std::int32_t i = 0; i != 8; ++i) {
+            const std::uint64_t p = cppr::RandomPrime(bits, rng);
+            if (cppr::internal::BitWidth(p) != bits || !cppr::IsPrime(p)) return false;
+            if (bits == 2) continue;
+            const std::uint64_t q = cppr::RandomSafePrime(bits, rng);
+            if (cppr::internal::BitWidth(q) != bits || !cppr::IsPrime(q) || !cppr::IsPrime(q >> 1)) return false;
+        }
+    }
+    return cppr::RandomPrime(1, rng) == 0 && cppr::RandomPrime(65, rng) == 0 && cppr::RandomSafePrime(2, rng) == 0;
+}
+template<class Mint> bool MontgomeryTest(const Mint& mint, std::uint64_t seed) {
+    const std::uint64_t n = mint.mod();
+    auto mulmod = [n](std::uint64_t a, std::uint64_t b) {
+        const cppr::internal::Int64Pair p = cppr::internal::Mulu128(a, b);
+        return cppr::internal::Divu128(p.high % n, p.low, n).low;
+    };
+    for (std::uint32_t i = 0; i != 1000; ++i) {
+        seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+        const std::uint64_t a = seed % n, ex = seed >> (i % 64);
+        std::uint64_t expected = 1 % n;
+        for (std::uint64_t b = a, e = ex; e != 0; e >>= 1, b = mulmod(b, b))
+            if (e & 1) expected = mulmod(expected, b);
+        const std::uint64_t x = mint.build(a);
+        if (mint.val(mint.pow(x, ex)) != expected) return false;
+        if (cppr::internal::GCD(a, n) == 1 ? !mint.same(mint.mul(x, mint.inv(x)), mint.one()) : !mint.is_zero(mint.inv(x))) return false;
+        const std::uint64_t bases[3] = { x, mint.build(seed >> 1), mint.build(~seed) };
+        std::uint64_t res[3], prod[3];
+        mint.pow(bases, ex, res);
+        mint.mul(bases, res, prod, 3);
+        for (std::size_t j = 0; j != 3; ++j)
+            if (!mint.same(res[j], mint.pow(bases[j], ex)) || !mint.same(prod[j], mint.mul(bases[j], res[j]))) return false;
+    }
+    return true;
+}
+#if defined(__SIZEOF_INT128__)
+bool IsPrime128Test(const std::vector<std::uint64_t>& primes, const std::vector<std::uint64_t>& composites) {
+    // Pairs of the high and low 64 bits. The composites start with strong pseudoprimes to base 2 of the form p(2p-1).
+    const std::uint64_t large_primes[][2] = { { 9223372036854775807u, 18446744073709551615u }, { 33554431u, 18446744073709551615u }, { 8796093022207u, 18446744073709551615u }, { 18446744073709551615u, 18446744073709551457u }, { 1u, 13u }, { 4571u, 10750541312280087033u }, { 65944746u, 3770023144559343277u }, { 3789830071u, 17813407672403329041u }, { 5982457282u, 1198620615364964605u }, { 39860035449u, 890389300140603689u }, { 3884482472193u, 18082527274286129875u }, { 88661708014989u, 14260338361632682877u }, { 181798113089397u, 9305701082707286179u }, { 507u, 7078656744852412691u }, { 1306644u, 6626211911680790435u }, { 2514716920540082u, 4384215682121156207u } };
+    const std::uint64_t large_composites[][2] = { { 106u, 9622001196940936245u }, { 26851936590u, 943770680443089541u }, { 13761348104u, 10045331875812558389u }, { 25147398651864u, 13352600593708206997u }, { 178148u, 14160095823135061553u }, { 3975u, 16627207563554288053u }, { 4071901u, 13225831676937804285u }, { 189881214189u, 3161085507968687329u }, { 18446744073709551498u, 3481u }, { 18446744073709551615u, 18446744073709551615u }, { 9223372036854775843u, 9223372036854776185u } };
+    for (const auto& x : large_primes)
+        if (!cppr::IsPrime(static_cast<unsigned __int128>(x[0]) << 64 | x[1])) return false;
+    for (const auto& x : large_composites)
+        if (cppr::IsPrime(static_cast<unsigned __int128>(x[0]) << 64 | x[1])) return false;
+    for (std::size_t i = 0; i < primes.size() && i < 10000; ++i) {
+        if (!cppr::IsPrime(static_cast<unsigned __int128>(primes[i]))) return false;
+        if (i != 0 && cppr::IsPrime(static_cast<unsigned __int128>(primes[i - 1]) * primes[i])) return false;
+    }
+    for (std::size_t i = 0; i < composites.size() && i < 10000; ++i)
+        if (cppr::IsPrime(static_cast<unsigned __int128>(composites[i]))) return false;
+    // Squares up to the largest below 2^128, where the square root has to stop before the quotient leaves 64 bits.
+    using Ops = cppr::internal::BailliePSWOps<unsigned __int128>;
+    const std::uint64_t roots[] = { 4294967311u, 9111001479u, 18446744073709551557u, 18446744073709551615u };
+    for (const std::uint64_t r : roots) {
+        const unsigned __int128 s = static_cast<unsigned __int128>(r) * r;
+        if (!Ops::IsSquare(s) || Ops::IsSquare(s - 1) || Ops::IsSquare(s + 1) || cppr::internal::GetLucasBaseImpl(s) != 0) return false;
+    }
+    return true;
+}
+#endif
+bool PrimePiTest() {
+    const std::uint64_t powers[] = { 0, 4, 25, 168, 1229, 9592, 78498, 664579, 5761455, 50847534, 455052511, 4118054813, 37607912018 };
+    std::uint64_t x = 1;
+    for (std::size_t k = 0; k != sizeof(powers) / sizeof(powers[0]); ++k, x *= 10)
+        if (cppr::PrimePi(x, k % 3) != powers[k]) return false;
+    // Both sides of the switch from the sieve to the combinatorial method, and a few larger values.
+    std::mt19937_64 rng(3);
+    const std::uint64_t values[] = { (1u << 24) - 1, 1u << 24, (1u << 24) + 1, 2147483647, 6000000000, 16777216 + rng() % 1000000000 };
+    for (const std::uint64_t v : values) {
+        std::uint64_t count = 0;
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 sum = 0;
+        cppr::ForEachPrime(0, v + 1, [&](std::uint64_t p) { ++count, sum += p; });
+        if (cppr::PrimeSum(v, 2) != sum) return false;
+#else
+        cppr::ForEachPrime(0, v + 1, [&](std::uint64_t) { ++count; });
+#endif
+        if (cppr::PrimePi(v, 1) != count || cppr::PrimePi(v, 3) != count) return false;
+    }
+    return true;
+}
+bool NthPrimeTest() {
+    const std::uint64_t powers[] = { 2, 29, 541, 7919, 104729, 1299709, 15485863, 179424673, 2038074743, 22801763489, 252097800623 };
+    std::uint64_t k = 1;
+    for (std::size_t i = 0; i != sizeof(powers) / sizeof(powers[0]); ++i, k *= 10)
+        if (cppr::NthPrime(k, i % 3) != powers[i]) return false;
+    // Both directions of the correction from a starting point.
+    const std::uint64_t x = 3000000000, count = cppr::PrimePi(x, 1);
+    for (const std::uint64_t j : { count - 100000, count, count + 1, count + 100000 })
+        if (cppr::internal::NthPrimeNear(j, x, count) != cppr::NthPrime(j, 1)) return false;
+    const char* path = "./nth_prime_index.tmp";
+    if (!cppr::PrimeCountIndex::Create(path, 100000000, 2)) return false;
+    cppr::PrimeCountIndex index(path);
+    std::remove(path);
+    if (!index.is_open() || index.bound() != 6 << 24 || index.count() != 5761455 + cppr::PrimeRange(100000000, 6 << 24).count()) return false;
+    std::mt19937_64 rng(4);
+    for (std::int32_t i = 0; i != 100; ++i) {
+        const std::uint64_t j = 1 + rng() % (index.count() + 1000);
+        if (cppr::NthPrime(j, index, 1) != cppr::NthPrime(j, 1)) return false;
+    }
+    return index.nth_prime(index.count() + 1) == 0 && cppr::NthPrime(0) == 0;
+}
+bool BatchRangeTest(const std::uint64_t lo, const std::uint64_t hi) {
+    std::vector<std::uint64_t> v;
+    for (std::uint64_t x = lo; x != hi; ++x) v.push_back(x);
+    std::unique_ptr<bool[]> res(new bool[v.size() + 1]);
+    cppr::IsPrimeBatch(v.data(), v.size(), res.get());
+    for (std::size_t i = 0; i != v.size(); ++i)
+        if (res[i] != cppr::IsPrime(v[i])) return false;
+    return true;
+}
+bool PrimalityCacheTest(const std::vector<std::uint64_t>& primes, const std::vector<std::uint64_t>& composites) {
+    // A small cache shared by 4 threads, so that the sets are overwritten while other threads read them.
+    std::vector<std::uint64_t> values;
+    for (std::size_t i = 0; i != primes.size() && values.size() != 256; ++i)
+        if (primes[i] > 0xffffffff) values.push_back(primes[i]);
+    for (std::size_t i = 0; i != composites.size() && values.size() != 512; ++i)
+        if (composites[i] > 0xffffffff) values.push_back(composites[i]);
+    for (std::uint64_t x = 18446744073709551615u; values.size() != 1024; x -= 2) values.push_back(x);
+    cppr::PrimalityCache cache(64);
+    bool ok[4] = {};
+    std::vector<std::thread> threads;
+    for (std::int32_t t = 0; t != 4; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937_64 rng(t);
+            ok[t] = true;
+            for (std::int32_t i = 0; i != 100000; ++i) {
+                const std::uint64_t x = values[rng() % (rng() % values.size() + 1)];
+                ok[t] &= cache.is_prime(x) == cppr::IsPrime(x);
+            }
+        });
+    }
+    for (std::thread& th : threads) th.join();
+    const cppr::PrimalityCache::Stats stats = cache.stats();
+    if (!ok[0] || !ok[1] || !ok[2] || !ok[3] || cache.capacity() != 64 || stats.hits == 0 || stats.misses == 0) return false;
+    cache.clear();
+    return cache.stats().hits == 0 && cache.is_prime(18446744073709551557u) && cache.is_prime(18446744073709551557u) && cache.stats().hits == 1;
+}
+bool LucasTest(const std::vector<std::uint64_t>& primes) {
+    for (std::uint64_t r = 0; r != 100000; ++r) {
+        const std::uint64_t s = 4294967295u - r;
+        if (!cppr::internal::IsSquare(r * r) || !cppr::internal::IsSquare(s * s) || cppr::internal::IsSquare(s * s + 1) || cppr::internal::IsSquare(s * s - 1) || (r > 1 && cppr::internal::IsSquare(r * r - 1))) return false;
+    }
+    for (std::size_t i = 0; i < primes.size() && i < 10000; ++i) {
+        const std::uint64_t p = primes[i];
+        if (p < 1000) continue;
+        const std::uint64_t D = cppr::internal::GetLucasBase(p);
+        const cppr::Montgomery64<true> m(p);
+        // Euler's criterion: (D / p) = -1 if and only if D^((p - 1) / 2) = -1 mod p.
+        if (D <= 1 || cppr::internal::Jacobi(p % D, D) != -1 || !m.same(m.pow(m.build(D), p >> 1), m.neg(m.one()))) return false;
+        if (!cppr::internal::StrongLucasTest(cppr::internal::MontgomeryModint64Impl<true>(p), D)) return false;
+    }
+    return cppr::internal::GetLucasBase(4294967291ull * 4294967291ull) == 0 && cppr::internal::GetLucasBase(29ull * 65537 * 29 * 65537) == 0;
+}
+bool StatsTest() {
+    typedef cppr::PrimalityStats Stats;
+    cppr::ResetThreadStats();
+    if (!cppr::IsPrime(1000003) || cppr::IsPrime(1000005) || !cppr::IsPrimeNoTable(18446744073709551557u)) return false;
+    Stats s = cppr::ThreadStats();
+    s += s;
+#ifdef LIBCPPRIME_STATS
+    if (s.calls() != 6 || s.tiers[Stats::Barrett32] != 2 || s.small_factor_exits != 2 || s.tiers[Stats::BailliePSW] != 2 || s.tiers[Stats::Lucas] != 2 || s.squarings == 0) return false;
+#ifdef LIBCPPRIME_STATS_LATENCY
+    std::uint64_t timed[Stats::EntryCount] = {};
+    for (std::int32_t e = 0; e != Stats::EntryCount; ++e)
+        for (const std::uint64_t c : s.latency[e]) timed[e] += c;
+    if (timed[Stats::IsPrimeEntry] != 4 || timed[Stats::IsPrimeNoTableEntry] != 2) return false;
+#endif
+#else
+    if (s.calls() != 0 || s.squarings != 0) return false;
+#endif
+    cppr::ResetThreadStats();
+    return cppr::ThreadStats().calls() == 0;
+}
 int main() {
     std::cout << ConstexprTest << std::endl;
+    std::vector<std::uint64_t> primes, composites;
     {
         std::ifstream ifs("./tests/Primes.txt");
         if (!ifs) return 1;
@@ -12,6 +311,7 @@ int main() {
         while (std::getline(ifs, line)) {
             std::uint64_t x = std::stoull(line);
             if (!cppr::IsPrime(x) || !cppr::IsPrimeNoTable(x)) return 1;
+            primes.push_back(x);
         }
     }
     {
@@ -21,6 +321,67 @@ int main() {
         while (std::getline(ifs, line)) {
             std::uint64_t x = std::stoull(line);
             if (cppr::IsPrime(x) || cppr::IsPrimeNoTable(x)) return 1;
+            composites.push_back(x);
         }
     }
+    // Strong pseudoprimes to all prime bases up to 7, 11, 13, 17 and 23, and Carmichael numbers (6k+1)(12k+1)(18k+1).
+    for (const std::uint64_t x : { 3215031751ull, 2152302898747ull, 3474749660383ull, 341550071728321ull, 3825123056546413051ull, 1299963601ull, 8986476721966264441ull })
+        if (cppr::IsPrime(x) || cppr::IsPrimeNoTable(x) || cppr::IsPrimeCT(x) || !HashedTest(x) || !TrialDivisionTest(x)) return 1;
+    if (!BatchTest(primes, true) || !BatchTest(composites, false)) return 1;
+    if (!BatchRangeTest(0, 300000) || !BatchRangeTest(2097152 - 100000, 2097152 + 100000) || !BatchRangeTest(4294967296u - 300000, 4294967296u + 100000)) return 1;
+    for (const std::vector<std::uint64_t>* v : { &primes, &composites })
+        for (const std::uint64_t x : *v)
+            if (!RangeTest(x) || !RangeTest(x >> 16) || !RangeTest(x >> 32)) return 1;
+    for (std::uint64_t x = 0; x != 200000; ++x)
+        if (!HashedTest(x) || !HashedTest(4294967296u - x) || !TrialDivisionTest(x) || !TrialDivisionTest(18446744073709551615u - x)) return 1;
+    for (std::uint64_t x = 0; x != 100000; ++x)
+        if (cppr::IsPrimeCT(x) != cppr::IsPrime(x) || cppr::IsPrimeCT(562949953421312u - x) != cppr::IsPrime(562949953421312u - x) || cppr::IsPrimeCT(18446744073709551615u - x) != cppr::IsPrime(18446744073709551615u - x)) return 1;
+    for (const std::vector<std::uint64_t>* v : { &primes, &composites })
+        for (const std::uint64_t x : *v)
+            if (!HashedTest(x) || !HashedTest(x >> 32) || !HashedTest(x >> 40) || !TrialDivisionTest(x) || cppr::IsPrimeCT(x) != cppr::IsPrime(x)) return 1;
+    if (!SieveTest(0, 1000000) || !SieveTest(0, 1000000, 64) || !SieveTest(1, 50) || !SieveTest(5, 6)) return 1;
+    if (!SieveTest(1000000000000, 1000001000000, 4096) || !SieveTest(1000000000000000000, 1000000000000300000)) return 1;
+    if (!SieveTest(18446744073709551615u - 300000, 18446744073709551615u) || !SieveTest(18446744073709551615u - 1000, 18446744073709551615u)) return 1;
+    if (!PrimeViewTest(0, 10000000) || !PrimeViewTest(0, 100000, 64) || !PrimeViewTest(7, 7) || !PrimeViewTest(8, 3) || !PrimeViewTest(1000000000000, 1000010000000)) return 1;
+    if (!PrimeViewTest(18446744073709551615u - 300000, 18446744073709551615u) || !PrimeViewTest(1000000000000000000, 1000000000002000000, 4096)) return 1;
+    if (!ParallelSieveTest(0, 30000000, 4, 4096) || !ParallelSieveTest(1000000000000000000, 1000000000030000000, 3, 64)) return 1;
+    if (cppr::CountPrimes(0, 1000000000, 4) != 50847534) return 1;
+    if (!PrimeBitmapTest(10000019) || !PrimeBitmapTest(1) || cppr::PrimeBitmap("./tests/NoSuchFile.bin").is_open()) return 1;
+    if (cppr::PrimeBitmap::Create("./tests/NoSuchFile.bin", 0) || std::ifstream("./tests/NoSuchFile.bin")) return 1;
+    for (std::uint64_t x = 0; x != 100000; ++x)
+        if (!NextPrimeTest(x) || !NextPrimeTest(4294967296u - 50000 + x) || !NextPrimeTest(18446744073709551615u - x)) return 1;
+    for (std::uint64_t i = 0, x = 88172645463325252u; i != 200000; ++i) {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+        if (!NextPrimeTest(x >> (i % 48))) return 1;
+    }
+    for (std::uint64_t x = 0; x != 100000; ++x)
+        if (!FactorizeTest(x) || !FactorizeTest(18446744073709551615u - x)) return 1;
+    for (std::uint64_t i = 0, x = 88172645463325252u; i != 20000; ++i) {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+        if (!FactorizeTest(x >> (i % 64))) return 1;
+    }
+    for (const std::uint64_t x : { 4294967291ull * 4294967291ull, 4294967279ull * 4294967291ull, 65521ull * 65521ull * 65521ull, 12157665459056928801ull, 614889782588491410ull })
+        if (!FactorizeTest(x)) return 1;
+    for (std::size_t i = 0; i < primes.size() && i < 1000; ++i)
+        if (!FactorizeTest(primes[i])) return 1;
+    for (std::size_t i = 0; i < composites.size() && i < 1000; ++i)
+        if (!FactorizeTest(composites[i])) return 1;
+    for (std::uint64_t i = 0, x = 88172645463325252u; i != 200; ++i) {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+        if (!MontgomeryTest(cppr::Montgomery64<>((x >> (2 + i % 62)) | 3), x) || !MontgomeryTest(cppr::Montgomery64<true>(x | 3), x)) return 1;
+    }
+    if (!MontgomeryTest(cppr::StaticMontgomery64<998244353>(), 1) || !MontgomeryTest(cppr::StaticMontgomery64<18446744073709551615u, true>(), 2)) return 1;
+#if defined(__SIZEOF_INT128__)
+    if (!IsPrime128Test(primes, composites)) return 1;
+#endif
+    {
+        std::mt19937 rng32(1);
+        std::mt19937_64 rng64(2);
+        if (!RandomPrimeTest(rng32) || !RandomPrimeTest(rng64)) return 1;
+    }
+    if (!PrimePiTest()) return 1;
+    if (!NthPrimeTest()) return 1;
+    if (!PrimalityCacheTest(primes, composites)) return 1;
+    if (!LucasTest(primes)) return 1;
+    if (!StatsTest()) return 1;
 }
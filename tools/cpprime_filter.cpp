@@ -0,0 +1,254 @@
+#include <libcpprime/IsPrime.hpp>
+#include <libcpprime/internal/ThreadPool.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FILTER_MMAP
+#endif
+// usage: cpprime_filter [--format text|binary] [--output primes|mask|count] [--threads N] [file ...]
+// Reads unsigned 64-bit integers from the files, or from stdin if there are none, and tests them with cppr::IsPrimeBatch.
+//   --format text     decimal numbers separated by any non-digit characters (default)
+//   --format binary   raw little-endian 8-byte integers
+//   --output primes   the primes in the input order, in the input format (default)
+//   --output mask     one bit per input, 1 for primes, packed from the least significant bit of each byte
+//   --output count    the number of primes and the number of inputs
+//   --threads N       the number of threads that test the numbers (default 1, 0 for one per hardware thread)
+// Regular files are mapped into memory and parsed in place. The numbers are tested in waves of chunks on the pool
+// while the calling thread parses the next wave and writes the results of the previous one, so the output keeps the input order.
+namespace {
+constexpr std::size_t ChunkSize = 1 << 14, ReadBytes = 1 << 22;
+class Writer {
+    std::unique_ptr<char[]> buffer_{ new char[1 << 20] };
+    std::size_t size_ = 0;
+public:
+    ~Writer() { flush(); }
+    void flush() {
+        std::fwrite(buffer_.get(), 1, size_, stdout);
+        size_ = 0;
+    }
+    void put(const char* s, const std::size_t n) {
+        if (size_ + n > (1 << 20)) flush();
+        std::memcpy(buffer_.get() + size_, s, n);
+        size_ += n;
+    }
+    void decimal(std::uint64_t x) {
+        char s[21];
+        char* p = s + 21;
+        *--p = '\n';
+        do *--p = static_cast<char>('0' + x % 10), x /= 10;
+        while (x != 0);
+        put(p, static_cast<std::size_t>(s + 21 - p));
+    }
+    void binary(const std::uint64_t x) {
+        char s[8];
+        for (int i = 0; i != 8; ++i) s[i] = static_cast<char>(x >> (8 * i));
+        put(s, 8);
+    }
+};
+// Turns the bytes of the input into numbers. A number may be split between two calls of feed, but not between two files:
+// finish ends the number in progress and is called at the end of every file.
+// A decimal number that does not fit in 64 bits is replaced by 0, so it is reported as not prime and keeps its place in the output.
+struct Parser {
+    bool binary = false, in_number = false, overflow = false;
+    std::uint64_t value = 0, overflows = 0, truncated = 0;
+    unsigned char carry[8] = {};
+    std::size_t carried = 0;
+    void feed(const char* p, const std::size_t n, std::vector<std::uint64_t>& out) {
+        const unsigned char* s = reinterpret_cast<const unsigned char*>(p);
+        if (binary) {
+            std::size_t i = 0;
+            if (carried != 0) {
+                i = 8 - carried < n ? 8 - carried : n;
+                std::memcpy(carry + carried, s, i);
+                if ((carried += i) != 8) return;
+                out.push_back(Load(carry)), carried = 0;
+            }
+            for (; i + 8 <= n; i += 8) out.push_back(Load(s + i));
+            carried = n - i;
+            std::memcpy(carry, s + i, carried);
+            return;
+        }
+        for (std::size_t i = 0; i != n; ++i) {
+            const std::uint32_t d = s[i] - static_cast<std::uint32_t>('0');
+            if (d < 10) {
+                overflow |= value > (18446744073709551615u - d) / 10;
+                value = value * 10 + d, in_number = true;
+            } else if (in_number) push(out);
+        }
+    }
+    void finish(std::vector<std::uint64_t>& out) {
+        if (in_number) push(out);
+        truncated += carried != 0;
+        carried = 0;
+    }
+    void push(std::vector<std::uint64_t>& out) {
+        overflows += overflow;
+        out.push_back(overflow ? 0 : value);
+        value = 0, in_number = false, overflow = false;
+    }
+    static std::uint64_t Load(const unsigned char* s) {
+        std::uint64_t x = 0;
+        for (int i = 0; i != 8; ++i) x |= static_cast<std::uint64_t>(s[i]) << (8 * i);
+        return x;
+    }
+};
+// Hands out the input piece by piece: a whole mapped file at once, or blocks of ReadBytes read from a stream.
+class Input {
+    std::vector<const char*> paths_;
+    std::size_t next_ = 0;
+    std::FILE* fp_ = nullptr;
+    std::unique_ptr<char[]> buffer_{ new char[ReadBytes] };
+#ifdef FILTER_MMAP
+    void* map_ = nullptr;
+    std::size_t map_bytes_ = 0;
+#endif
+    void release() {
+#ifdef FILTER_MMAP
+        if (map_ != nullptr) ::munmap(map_, map_bytes_), map_ = nullptr;
+#endif
+        if (fp_ != nullptr && fp_ != stdin) std::fclose(fp_);
+        fp_ = nullptr, ++released;
+    }
+public:
+    bool failed = false;
+    // The number of files released so far. A change means the previous file has ended.
+    std::size_t released = 0;
+    explicit Input(std::vector<const char*> paths) : paths_(static_cast<std::vector<const char*>&&>(paths)) {
+        if (paths_.empty()) fp_ = stdin;
+    }
+    ~Input() { release(); }
+    // Returns false at the end of the input.
+    bool read(const char*& data, std::size_t& n) {
+        while (true) {
+            if (fp_ != nullptr) {
+                n = std::fread(buffer_.get(), 1, ReadBytes, fp_);
+                if (n != 0) {
+                    data = buffer_.get();
+                    return true;
+                }
+                failed |= std::ferror(fp_) != 0;
+                release();
+                if (paths_.empty()) return false;
+            } else release();
+            if (next_ == paths_.size()) return false;
+            const char* path = paths_[next_++];
+#ifdef FILTER_MMAP
+            const int fd = ::open(path, O_RDONLY);
+            struct stat st;
+            if (fd >= 0 && ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+                void* map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (map != MAP_FAILED) {
+                    ::madvise(map, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+                    map_ = map, map_bytes_ = static_cast<std::size_t>(st.st_size);
+                    data = static_cast<const char*>(map), n = map_bytes_;
+                    return true;
+                }
+            } else if (fd >= 0) ::close(fd);
+#endif
+            fp_ = std::fopen(path, "rb");
+            if (fp_ == nullptr) {
+                std::fprintf(stderr, "failed to open %s\n", path);
+                failed = true;
+            }
+        }
+    }
+};
+}  // namespace
+int main(int argc, char** argv) {
+    bool binary = false;
+    std::string output = "primes";
+    std::size_t threads = 1;
+    std::vector<const char*> paths;
+    for (int i = 1; i < argc; ++i) {
+        const std::string opt = argv[i];
+        if (opt == "--format" && i + 1 < argc) {
+            const std::string v = argv[++i];
+            if (v != "text" && v != "binary") return std::fprintf(stderr, "unknown format %s\n", v.c_str()), 2;
+            binary = v == "binary";
+        } else if (opt == "--output" && i + 1 < argc) {
+            output = argv[++i];
+            if (output != "primes" && output != "mask" && output != "count") return std::fprintf(stderr, "unknown output %s\n", output.c_str()), 2;
+        } else if (opt == "--threads" && i + 1 < argc) threads = cppr::internal::ThreadCount(static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10)));
+        else if (opt.size() > 1 && opt[0] == '-') return std::fprintf(stderr, "usage: %s [--format text|binary] [--output primes|mask|count] [--threads N] [file ...]\n", argv[0]), 2;
+        else paths.push_back(argv[i]);
+    }
+    Input input(paths);
+    Parser parser;
+    parser.binary = binary;
+    Writer writer;
+    cppr::internal::WorkStealingPool pool(threads);
+    const std::size_t wave = ChunkSize * 4 * pool.size();
+    std::vector<std::uint64_t> numbers[2];
+    std::unique_ptr<bool[]> results[2] = { std::unique_ptr<bool[]>(new bool[wave + ReadBytes]), std::unique_ptr<bool[]>(new bool[wave + ReadBytes]) };
+    const char* data = nullptr;
+    std::size_t bytes = 0, consumed = 0;
+    bool end = false;
+    // Parses at least wave numbers into v unless the input ends. A mapped file is parsed in slices of ReadBytes.
+    auto fill = [&](std::vector<std::uint64_t>& v) {
+        v.clear();
+        while (v.size() < wave && !end) {
+            if (consumed == bytes) {
+                const std::size_t released = input.released;
+                end = !input.read(data, bytes);
+                if (end || input.released != released) parser.finish(v);
+                if (end) break;
+                consumed = 0;
+            }
+            const std::size_t n = bytes - consumed < ReadBytes ? bytes - consumed : ReadBytes;
+            parser.feed(data + consumed, n, v);
+            consumed += n;
+        }
+    };
+    std::uint64_t primes = 0, total = 0;
+    std::uint8_t mask = 0;
+    std::int32_t mask_bits = 0;
+    const bool print_primes = output == "primes", print_mask = output == "mask";
+    auto write = [&](const std::vector<std::uint64_t>& v, const bool* r) {
+        total += v.size();
+        for (std::size_t i = 0; i != v.size(); ++i) {
+            primes += r[i];
+            if (print_primes) {
+                if (!r[i]) continue;
+                if (binary) writer.binary(v[i]);
+                else writer.decimal(v[i]);
+            } else if (print_mask) {
+                mask |= static_cast<std::uint8_t>(r[i] << mask_bits);
+                if (++mask_bits == 8) writer.put(reinterpret_cast<const char*>(&mask), 1), mask = 0, mask_bits = 0;
+            }
+        }
+    };
+    std::size_t current = 0;
+    fill(numbers[current]);
+    while (!numbers[current].empty()) {
+        const std::vector<std::uint64_t>& v = numbers[current];
+        bool* r = results[current].get();
+        auto task = [&](std::size_t, const std::uint32_t index, std::uint32_t) {
+            const std::size_t begin = index * ChunkSize, n = v.size() - begin < ChunkSize ? v.size() - begin : ChunkSize;
+            cppr::IsPrimeBatch(v.data() + begin, n, r + begin);
+        };
+        pool.Start(static_cast<std::uint32_t>((v.size() + ChunkSize - 1) / ChunkSize), task);
+        fill(numbers[current ^ 1]);
+        pool.Wait();
+        write(v, r);
+        current ^= 1;
+    }
+    if (mask_bits != 0) writer.put(reinterpret_cast<const char*>(&mask), 1);
+    if (output == "count") {
+        char s[64];
+        const int n = std::snprintf(s, sizeof(s), "%llu %llu\n", static_cast<unsigned long long>(primes), static_cast<unsigned long long>(total));
+        writer.put(s, static_cast<std::size_t>(n));
+    }
+    writer.flush();
+    if (parser.overflows != 0) std::fprintf(stderr, "%llu numbers did not fit in 64 bits and were reported as not prime\n", static_cast<unsigned long long>(parser.overflows));
+    if (parser.truncated != 0) std::fprintf(stderr, "%llu files ended in the middle of a number\n", static_cast<unsigned long long>(parser.truncated));
+    return input.failed || parser.overflows != 0 || parser.truncated != 0 ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+#include <libcpprime/Montgomery.hpp>
+#include <libcpprime/PrimeSieve.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+// usage: gen_bases [options]
+//   --bits B           the table has 2^B entries (default 8)
+//   --multiplier M     the hash is (uint32(x) * M) >> (32 - B) (default 0xad625b89)
+//   --per-entry K      hashed bases per entry, 1 or 2 (default 1)
+//   --bound N          the table must be correct for x < N (default 2^32)
+//   --base2 0|1        test base 2 before the hashed bases (default 0)
+//   --pseudoprimes F   read the base-2 strong pseudoprimes below N from F, one per line; implies --base2 1
+//   --name S           the name of the generated struct (default HashedBases)
+//
+// Without --pseudoprimes, the odd composites in [85849, N) that have no prime factor up to 17 are enumerated bucket by bucket
+// by inverting the hash, so N must be at most 2^32. Every one of them that passes base 2 (with --base2 1) must fail the hashed bases.
+// With --pseudoprimes, only the listed numbers must fail the hashed bases.
+// For N = 2^64 this needs the list of Feitsma and Galway, which has about 3.2e7 entries below 2^64.
+// The result is printed as a table and a struct for cppr::IsPrimeHashed.
+namespace {
+bool IsStrongProbablePrime(const std::uint64_t x, const std::uint64_t base) {
+    const cppr::Montgomery64<true> mint(x);
+    const std::int32_t s = cppr::internal::CountrZero(x - 1);
+    std::uint64_t a = mint.pow(mint.build(base), (x - 1) >> s);
+    const std::uint64_t one = mint.one(), mone = mint.neg(one);
+    if (mint.same(a, one) || mint.same(a, mone)) return true;
+    for (std::int32_t i = 1; i != s; ++i) {
+        a = mint.mul(a, a);
+        if (mint.same(a, mone)) return true;
+    }
+    return false;
+}
+// Returns the smallest base in [first, 65536) that every number in v fails, or 0 if there is none.
+// Strong pseudoprimes to one base are often pseudoprimes to many others, so the numbers that rejected
+// a base are moved to the front and tried first for the next one.
+std::uint32_t FindBase(std::vector<std::uint64_t>& v, const std::uint32_t first) {
+    std::size_t killers = 0;
+    for (std::uint32_t base = first; base != 65536; ++base) {
+        bool ok = true;
+        for (std::size_t i = 0; i != v.size(); ++i) {
+            if (v[i] % base == 0 || !IsStrongProbablePrime(v[i], base)) continue;
+            if (i >= killers) std::swap(v[i], v[killers++]);
+            ok = false;
+            break;
+        }
+        if (ok) return base;
+    }
+    return 0;
+}
+// Chooses a pair of bases: the first of the first 256 candidates that leaves the fewest survivors, then a base for those.
+// The candidates are compared on a prefix of v only, because a bucket may hold millions of composites.
+bool FindBasePair(std::vector<std::uint64_t>& v, std::uint32_t& base1, std::uint32_t& base2) {
+    const std::size_t sample = v.size() < 4096 ? v.size() : 4096;
+    std::size_t best = ~std::size_t(0);
+    for (std::uint32_t base = 3; base != 259 && best != 0; ++base) {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i != sample; ++i) count += v[i] % base != 0 && IsStrongProbablePrime(v[i], base);
+        if (count < best) best = count, base1 = base;
+    }
+    std::vector<std::uint64_t> survivors;
+    for (const std::uint64_t x : v)
+        if (x % base1 != 0 && IsStrongProbablePrime(x, base1)) survivors.push_back(x);
+    base2 = survivors.empty() ? base1 : FindBase(survivors, 3);
+    return base2 != 0;
+}
+}  // namespace
+int main(int argc, char** argv) {
+    std::int32_t bits = 8, per_entry = 1;
+    std::uint32_t multiplier = 0xad625b89u;
+    std::uint64_t bound = 4294967296ull;
+    bool base2 = false;
+    const char* pseudoprimes = nullptr;
+    std::string name = "HashedBases";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string opt = argv[i];
+        if (opt == "--bits") bits = std::atoi(argv[i + 1]);
+        else if (opt == "--multiplier") multiplier = static_cast<std::uint32_t>(std::strtoul(argv[i + 1], nullptr, 0));
+        else if (opt == "--per-entry") per_entry = std::atoi(argv[i + 1]);
+        else if (opt == "--bound") bound = std::strtoull(argv[i + 1], nullptr, 0);
+        else if (opt == "--base2") base2 = std::atoi(argv[i + 1]) != 0;
+        else if (opt == "--pseudoprimes") pseudoprimes = argv[i + 1], base2 = true;
+        else if (opt == "--name") name = argv[i + 1];
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (bits < 1 || bits > 20 || multiplier % 2 == 0 || (per_entry != 1 && per_entry != 2) || (pseudoprimes == nullptr && bound > 4294967296ull)) {
+        std::fprintf(stderr, "invalid options\n");
+        return 2;
+    }
+    const std::uint32_t size = std::uint32_t(1) << bits;
+    auto hash = [=](std::uint64_t x) { return static_cast<std::uint32_t>(static_cast<std::uint32_t>(x) * multiplier) >> (32 - bits); };
+    std::vector<std::vector<std::uint64_t>> buckets;
+    std::vector<std::uint8_t> sieve;
+    std::uint32_t inverse = multiplier;
+    for (std::int32_t i = 0; i != 5; ++i) inverse *= 2 - multiplier * inverse;
+    if (pseudoprimes != nullptr) {
+        buckets.resize(size);
+        std::FILE* fp = std::fopen(pseudoprimes, "r");
+        if (fp == nullptr) {
+            std::fprintf(stderr, "failed to open %s\n", pseudoprimes);
+            return 1;
+        }
+        unsigned long long x = 0;
+        std::size_t count = 0;
+        while (std::fscanf(fp, "%llu", &x) == 1)
+            if (x < bound && x >= 85849 && !cppr::internal::HasSmallFactor(x)) buckets[hash(x)].push_back(x), ++count;
+        std::fclose(fp);
+        std::fprintf(stderr, "%zu pseudoprimes\n", count);
+    } else {
+        cppr::internal::SegmentedSieve s(0, bound, std::size_t(1) << 20);
+        for (std::size_t n = 0; (n = s.next()) != 0;) sieve.insert(sieve.end(), s.data(), s.data() + n);
+    }
+    std::vector<std::uint32_t> table(size * per_entry);
+    for (std::uint32_t h = 0; h != size; ++h) {
+        std::vector<std::uint64_t> v;
+        if (pseudoprimes != nullptr) v.swap(buckets[h]);
+        else {
+            for (std::uint64_t t = 0; t >> (32 - bits) == 0; ++t) {
+                const std::uint64_t x = static_cast<std::uint32_t>((std::uint64_t(h) << (32 - bits) | t) * inverse);
+                if (x < 85849 || x >= bound || cppr::internal::HasSmallFactor(x)) continue;
+                if (!((sieve[x / 30] >> cppr::internal::WheelIndex[x % 30]) & 1) && (!base2 || IsStrongProbablePrime(x, 2))) v.push_back(x);
+            }
+        }
+        bool ok = true;
+        if (per_entry == 1) ok = (table[h] = FindBase(v, base2 ? 3 : 2)) != 0;
+        else ok = FindBasePair(v, table[2 * h], table[2 * h + 1]);
+        if (!ok) {
+            std::fprintf(stderr, "no base found for bucket %u; try another multiplier or more bits\n", h);
+            return 1;
+        }
+        std::fprintf(stderr, "\rbucket %u / %u", h + 1, size);
+    }
+    std::fprintf(stderr, "\n");
+    std::printf("constexpr std::uint16_t %sData[%u] = {", name.c_str(), size * per_entry);
+    for (std::uint32_t i = 0; i != size * per_entry; ++i) std::printf("%s%u", i % 16 == 0 ? "\n    " : " ", table[i]), std::printf(i + 1 != size * per_entry ? "," : "\n");
+    std::printf("};\n");
+    std::printf("struct %s {\n", name.c_str());
+    std::printf("    static constexpr std::int32_t Bits = %d, PerEntry = %d;\n", bits, per_entry);
+    std::printf("    static constexpr std::uint32_t Multiplier = 0x%08xu;\n", multiplier);
+    std::printf("    static constexpr std::uint64_t Bound = %lluu;\n", static_cast<unsigned long long>(bound));
+    std::printf("    static constexpr bool Base2 = %s;\n", base2 ? "true" : "false");
+    std::printf("    static constexpr std::uint16_t Base(const std::uint32_t i) noexcept { return %sData[i]; }\n", name.c_str());
+    std::printf("};\n");
+}
@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+// usage: gen_corpus [count] > Adversarial.txt
+// Writes the inputs that drive cppr::IsPrime and cppr::IsPrimeNoTable into their slowest paths, at most count (default 256)
+// of each kind in each bit range, as lines of "<kind> <bucket> <expected> <n>" where expected is 1 for primes.
+//   spsp2        strong pseudoprimes to base 2, which pass the first round and reach the last base or the Lucas test
+//   carmichael   Carmichael numbers (6k+1)(12k+1)(18k+1), Fermat pseudoprimes to every base coprime to them
+//   max2adic     primes and composites k * 2^s + 1 with the largest s for their size, for the longest squaring loops
+//   boundary     the largest primes below 2^32, 2^49, 2^62 and 2^64, where the tiers of IsPrime switch
+// The numbers are labelled with a deterministic Miller-Rabin test written here, independently of the library.
+// The output only depends on count, so the corpus can be regenerated bit for bit.
+namespace {
+struct Bucket {
+    const char* name;
+    int low_bits, high_bits;  // the numbers are in [2^low_bits, 2^high_bits)
+};
+constexpr Bucket Buckets[] = { { "<=32", 16, 32 }, { "<=49", 32, 49 }, { "<=62", 49, 62 }, { "<=64", 62, 64 } };
+std::uint64_t MulMod(const std::uint64_t a, const std::uint64_t b, const std::uint64_t n) { return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % n); }
+bool IsStrongProbablePrime(const std::uint64_t n, const std::uint64_t base) {
+    std::uint64_t d = n - 1, x = 1, b = base % n;
+    int s = 0;
+    while (d % 2 == 0) d /= 2, ++s;
+    for (; d != 0; d >>= 1, b = MulMod(b, b, n))
+        if (d & 1) x = MulMod(x, b, n);
+    if (x == 1 || x == n - 1) return true;
+    for (int i = 1; i < s; ++i)
+        if ((x = MulMod(x, x, n)) == n - 1) return true;
+    return false;
+}
+// The first 12 prime bases are enough below 3.18 * 10^23, so for every 64-bit n.
+bool IsPrimeReference(const std::uint64_t n) {
+    const std::uint64_t primes[12] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+    for (const std::uint64_t p : primes)
+        if (n % p == 0) return n == p;
+    if (n < 2) return false;
+    for (const std::uint64_t p : primes)
+        if (!IsStrongProbablePrime(n, p)) return false;
+    return true;
+}
+bool HasFactorBelow(const std::uint64_t n, const std::uint64_t bound) {
+    for (std::uint64_t p = 2; p < bound; ++p)
+        if (n % p == 0 && n != p) return true;
+    return false;
+}
+bool InBucket(const std::uint64_t n, const Bucket& b) { return n >> b.low_bits != 0 && (b.high_bits == 64 || n >> b.high_bits == 0); }
+void Print(const char* kind, const Bucket& b, const std::uint64_t n) { std::printf("%s %s %d %llu\n", kind, b.name, IsPrimeReference(n) ? 1 : 0, static_cast<unsigned long long>(n)); }
+}  // namespace
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 256;
+    std::mt19937_64 rng(998244353);
+    // Strong pseudoprimes to all prime bases up to 7, 11, 13, 17 and 23.
+    const std::uint64_t known[] = { 3215031751u, 2152302898747u, 3474749660383u, 341550071728321u, 3825123056546413051u };
+    for (const Bucket& b : Buckets) {
+        std::vector<std::uint64_t> v;
+        for (const std::uint64_t n : known)
+            if (InBucket(n, b)) v.push_back(n);
+        // n = p(1 + m(p - 1)) is a strong pseudoprime to base 2 often enough when both factors are prime.
+        const int half = b.high_bits / 2;
+        while (v.size() < count) {
+            const std::uint64_t p = ((std::uint64_t(1) << (half - 2)) + (rng() & ((std::uint64_t(1) << (half - 2)) - 1))) | 1, m = 2 + rng() % 3, q = 1 + m * (p - 1);
+            if (static_cast<unsigned __int128>(p) * q >> 64 != 0 || !InBucket(p * q, b)) continue;
+            if (IsPrimeReference(p) && IsPrimeReference(q) && IsStrongProbablePrime(p * q, 2)) v.push_back(p * q);
+        }
+        for (const std::uint64_t n : v) Print("spsp2", b, n);
+    }
+    for (const Bucket& b : Buckets) {
+        std::size_t found = 0;
+        for (std::uint64_t k = 1; found < count; ++k) {
+            const std::uint64_t p = 6 * k + 1, q = 12 * k + 1, r = 18 * k + 1;
+            const unsigned __int128 n = static_cast<unsigned __int128>(p * q) * r;
+            if (n >> 64 != 0 || (b.high_bits != 64 && n >> b.high_bits != 0)) break;
+            if (n >> b.low_bits == 0 || !IsPrimeReference(p) || !IsPrimeReference(q) || !IsPrimeReference(r)) continue;
+            Print("carmichael", b, static_cast<std::uint64_t>(n)), ++found;
+        }
+        if (found < count) std::fprintf(stderr, "only %zu Carmichael numbers of the form (6k+1)(12k+1)(18k+1) in %s\n", found, b.name);
+    }
+    for (const Bucket& b : Buckets) {
+        // n = k * 2^s + 1 with odd k and n just below 2^high_bits, from the largest s down. Numbers with a factor up to 17 are
+        // skipped, because IsPrime rejects them before any Miller-Rabin round.
+        std::size_t primes = 0, composites = 0;
+        for (int s = b.high_bits - 2; s != 0 && (primes < count / 2 || composites < count / 2); --s) {
+            for (std::uint64_t k = (std::uint64_t(1) << (b.high_bits - 1 - s)) | 1; k >> (b.high_bits - s) == 0; k += 2) {
+                const std::uint64_t n = (k << s) + 1;
+                if (HasFactorBelow(n, 18)) continue;
+                std::size_t& found = IsPrimeReference(n) ? primes : composites;
+                if (found < count / 2) Print("max2adic", b, n), ++found;
+            }
+        }
+    }
+    for (const Bucket& b : Buckets) {
+        std::size_t found = 0;
+        for (std::uint64_t n = b.high_bits == 64 ? 18446744073709551615u : (std::uint64_t(1) << b.high_bits) - 1; found < count; n -= 2)
+            if (IsPrimeReference(n)) Print("boundary", b, n), ++found;
+    }
+}
@@ -0,0 +1,26 @@
+#include <libcpprime/PrimeBitmap.hpp>
+#include <cstdio>
+#include <cstdlib>
+// usage: prime_bitmap <output file> [bound]
+// Writes the table of the primes below bound (default 2^32, about 137MB) for cppr::PrimeBitmap.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <output file> [bound]\n", argv[0]);
+        return 2;
+    }
+    const std::uint64_t bound = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4294967296ull;
+    if (bound == 0) {
+        std::fprintf(stderr, "the bound must be positive\n");
+        return 2;
+    }
+    if (!cppr::PrimeBitmap::Create(argv[1], bound)) {
+        std::fprintf(stderr, "failed to write %s\n", argv[1]);
+        return 1;
+    }
+    const cppr::PrimeBitmap bitmap(argv[1]);
+    if (!bitmap.is_open() || bitmap.bound() != bound) {
+        std::fprintf(stderr, "failed to read back %s\n", argv[1]);
+        return 1;
+    }
+    std::printf("wrote the primes below %llu to %s\n", static_cast<unsigned long long>(bound), argv[1]);
+}
@@ -0,0 +1,28 @@
+#include <libcpprime/NthPrime.hpp>
+#include <cstdio>
+#include <cstdlib>
+// usage: prime_count_index <output file> [bound] [threads]
+// Writes the number of primes below every multiple of 2^24 up to bound (default 2^40, about 512KB) for cppr::PrimeCountIndex.
+// The blocks are sieved on threads threads (default 0, one per hardware thread).
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <output file> [bound] [threads]\n", argv[0]);
+        return 2;
+    }
+    const std::uint64_t bound = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1099511627776ull;
+    const std::size_t threads = argc > 3 ? static_cast<std::size_t>(std::strtoull(argv[3], nullptr, 10)) : 0;
+    if (bound == 0) {
+        std::fprintf(stderr, "the bound must be positive\n");
+        return 2;
+    }
+    if (!cppr::PrimeCountIndex::Create(argv[1], bound, threads)) {
+        std::fprintf(stderr, "failed to write %s\n", argv[1]);
+        return 1;
+    }
+    const cppr::PrimeCountIndex index(argv[1]);
+    if (!index.is_open() || index.bound() < bound) {
+        std::fprintf(stderr, "failed to read back %s\n", argv[1]);
+        return 1;
+    }
+    std::printf("wrote the counts of the primes below %llu (%llu primes) to %s\n", static_cast<unsigned long long>(index.bound()), static_cast<unsigned long long>(index.count()), argv[1]);
+}